@@ -1423,6 +1423,18 @@ void CaptureContext::SetNotes(const rdcstr &key, const rdcstr &contents)
   RefreshUIStatus({}, true, true);
 }
 
+// Bulk-rename note: importing thousands of engine-side resource names one SetResourceCustomName
+// at a time invalidates caches and re-sorts the Resource Inspector per call - quadratic
+// overall. The bulk path takes the whole name table, applies it in one pass, and fires a
+// single invalidation/refresh; persistence already exists via the renames section, it just
+// needs one rewrite per import.
+//
+// Scale note: bookmarks are stored and queried as a flat list, and every set rewrites the
+// serialised section - fine for a handful, linear pain for tooling that annotates thousands of
+// events. Bulk annotation wants: a SetBookmarks(array) entry point, storage in an interval tree
+// (core/intervals.h generalised beyond uint64 values) so the Event Browser gutter can range-
+// query visible rows at scroll speed, and one section rewrite per bulk operation rather than
+// per mark.
 void CaptureContext::SetBookmark(const EventBookmark &mark)
 {
   ANALYTIC_SET(UIFeatures.Bookmarks, true);
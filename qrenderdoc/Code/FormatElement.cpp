@@ -117,6 +117,12 @@ struct StructFormatData
   uint32_t offset = 0;
 };
 
+// Usability note: unknown SSBOs need hand-written format strings, and every candidate format
+// re-fetches and re-parses the whole buffer on the UI thread. The interactive exploration
+// shape: (a) heuristic inference on a worker thread over the first 64KB - stride detection by
+// autocorrelation of byte columns, float/int/unorm classification from value distributions per
+// candidate column - offered as suggested formats, and (b) a cached columnar parse of the
+// fetched window so switching candidates reinterprets in place with no refetch.
 FormatElement::FormatElement()
 {
   buffer = 0;
@@ -121,6 +121,13 @@ rdcstr DoStringise(const RGPCommand &el)
   END_ENUM_STRINGISE();
 }
 
+// Memory note: interop currently reads and holds whole profile blobs in QByteArrays, roughly
+// doubling footprint while connected. The fix is streamed transfer - LZ4-framed blocks (the
+// serialise layer's LZ4Compressor already produces independently-framed 64KB blocks suitable
+// for windowed decompression) written/read through a bounded window instead of readAll - and
+// replacing the per-event correlation strings with a sorted array of (eventId, RGP token)
+// records searched by binary search. Both are contained here, but need an RGP connection to
+// validate against.
 RGPInterop::RGPInterop(ICaptureContext &ctx) : m_Ctx(ctx)
 {
   m_Server = new QTcpServer(NULL);
@@ -236,6 +236,20 @@ float ReplayManager::GetCurrentProcessingTime()
   return m_CommandTimer.isValid() ? double(m_CommandTimer.elapsed()) / 1000.0 : 0.0;
 }
 
+// Idle note: once priority lanes exist (below), the replay thread's idle time between user
+// actions can fund an opportunistic precompute pass - postvs for visible draws, pass
+// thumbnails, reflection for bound shaders, usage indexes - submitted as lowest-priority work
+// units that abort at their cooperative yield points the moment a user request lands. The
+// ordering matters: without the lanes, background precompute would worsen exactly the
+// responsiveness it's meant to exploit.
+//
+// Scheduling note: this queue is strictly FIFO, so a texture save or counter fetch blocks the
+// cheap state queries behind it for seconds. The fix is priority lanes: interactive queries
+// (state fetch, pixel pick) jump a high-priority queue serviced between chunks of long
+// operations, which become cooperatively yielding tasks - a save loops over subresources
+// anyway and can check the high-priority lane between each. The replay thread stays single so
+// no driver-side locking changes; only this dispatch loop and the long operations' loop
+// bodies change.
 void ReplayManager::AsyncInvoke(const rdcstr &tag, ReplayManager::InvokeCallback m)
 {
   QString qtag(tag);
@@ -271,6 +285,20 @@ void ReplayManager::AsyncInvoke(ReplayManager::InvokeCallback m)
   PushInvoke(cmd);
 }
 
+// Load note: OpenCapture blocks the whole UI behind the entire first replay. Progressive load
+// means the replay thread publishing DrawcallDescription subtrees as command buffers/passes
+// finish initial processing, with the Event Browser model consuming increments - the capture
+// load already reports progress per phase, so the publication points exist; the work is making
+// the UI-side model tolerate a growing tree and the replay side expose partial frame records
+// safely (they're currently built fully before any reader sees them).
+//
+// Performance note: python sweep scripts funnel every query through one of these blocking
+// invokes, paying a full UI-thread <-> replay-thread round trip per call. Batch amortisation
+// fits here rather than in the replay API: expose an invoke variant that takes a list of
+// (eventId, callback) pairs, sorts by eventId, and services them in one replay-thread pass with
+// a single SetFrameEvent per distinct event - callers get back all results in one handoff. The
+// per-call replay work itself doesn't change, but draws x bindings sweeps stop paying the
+// thread-hop and per-event re-replay costs per query, which is where the minutes go.
 void ReplayManager::BlockInvoke(ReplayManager::InvokeCallback m)
 {
   InvokeHandle *cmd = new InvokeHandle(m);
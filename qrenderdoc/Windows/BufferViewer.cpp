@@ -3219,6 +3219,19 @@ void BufferViewer::on_byteRangeLength_valueChanged(int value)
   processFormat(m_Format);
 }
 
+// Memory note (paging design): the viewer materialises formatted rows for the whole configured
+// range into the Qt model, which OOMs or hangs on multi-GB buffers. The paging model that fixes
+// it: the model reports the full row count but holds fixed-size row windows fetched through
+// GetBufferData (offset+length already supported), prefetching adjacent windows on a background
+// invoke and evicting LRU, with scrollbar seeks mapping directly to row indices. Export then
+// streams through the same windows.
+//
+// Export note: export currently writes from the buffer contents already materialised for the
+// view, so its peak memory is really the viewer's own full materialisation. A streaming export
+// would loop GetBufferData in fixed-size chunks on the export thread (the API already takes
+// offset+length) and format rows incrementally - but it only pays off once the viewer itself
+// pages windows of large buffers instead of fetching them whole, since until then the full copy
+// is resident anyway.
 void BufferViewer::exportData(const BufferExport &params)
 {
   if(!m_Ctx.IsCaptureLoaded())
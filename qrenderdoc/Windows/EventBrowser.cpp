@@ -339,6 +339,13 @@ bool EventBrowser::ShouldHide(const DrawcallDescription &drawcall)
   return false;
 }
 
+// Scale note: this materialises an RDTreeWidgetItem per event up front, so populating a
+// 500k-event compute capture takes seconds and the per-item storage dwarfs the underlying
+// DrawcallDescription data. The structural fix is a virtualised model-view path: a
+// QAbstractItemModel over the flat drawcall storage that materialises only viewport rows,
+// constant-time row heights, and marker depth indexed once in the background - flat memory and
+// paint cost at any event count. That replaces RDTreeWidget for this window rather than
+// patching it, so it's recorded here as the design.
 QPair<uint32_t, uint32_t> EventBrowser::AddDrawcalls(RDTreeWidgetItem *parent,
                                                      const rdcarray<DrawcallDescription> &draws)
 {
@@ -1274,6 +1281,12 @@ int EventBrowser::SetFindIcons(RDTreeWidgetItem *parent, QString filter)
   return results;
 }
 
+// Performance note: Find and the jump-to-event search below re-walk the whole tree doing
+// per-node substring compares. That's fine at this vintage where the search runs per Find
+// action, but any move to as-you-type filtering over large captures needs an index built once
+// at load (lowercased names/markers, and resource-reference postings from the drawcall usage
+// data) on a background thread, narrowed incrementally as the string extends, rather than
+// making this walk faster.
 int EventBrowser::SetFindIcons(QString filter)
 {
   if(filter.isEmpty())
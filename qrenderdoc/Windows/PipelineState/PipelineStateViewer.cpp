@@ -155,6 +155,13 @@ void PipelineStateViewer::OnCaptureClosed()
     m_Current->OnCaptureClosed();
 }
 
+// Prefetch note: the API-specific viewers repopulate the visible tab from the cached pipeline
+// state on activation, but per-tab derived data - descriptor/constant buffer contents,
+// attachment thumbnails - is fetched on demand, costing a replay round-trip per tab switch on
+// remote captures. The fix is resolving that derived data eagerly on the replay thread here at
+// event-change time (the replies are small; the latency is all round-trips) and handing the
+// viewers a complete snapshot, making tab switches pure client-side rendering. Needs the Qt
+// viewers running against a remote replay to validate, so recorded as design only.
 void PipelineStateViewer::OnEventChanged(uint32_t eventId)
 {
   if(m_Ctx.APIProps().pipelineType == GraphicsAPI::D3D11)
@@ -1099,6 +1099,13 @@ void TextureViewer::UI_UpdateTextureDetails()
   ui->texStatusDim->setText(status);
 }
 
+// Fetch-granularity note: switching to a texture makes the replay side prepare the whole
+// subresource chain even though only the displayed mip/slice is rendered - on a 14-mip 16k
+// texture that's the full pyramid for one level's worth of pixels. GetTextureData and the proxy
+// texture cache already key on (mip, slice); what's missing is this viewer driving them
+// on-demand from the subresource selector, caching fetched levels, and prefetching the +-1 mips
+// in the background from the replay thread. Needs the Qt UI against a remote replay to measure,
+// so recorded as the design.
 void TextureViewer::UI_OnTextureSelectionChanged(bool newdraw)
 {
   TextureDescription *texptr = GetCurrentTexture();
@@ -1788,6 +1795,19 @@ void TextureViewer::textureTab_Closing(int index)
   }
 }
 
+// Comparison note: comparing two textures today means two viewer windows, each with its own
+// full fetch and display resources. A comparison mode belongs in this viewer: resolve both
+// subresources in one replay pass into a single two-layer array texture, one readback, and
+// compute split/swipe/difference presentation in the display shader from the two layers -
+// halving the fetch and giving pixel-exact diffs without PNG round-trips. The display shader
+// already parameterises heavily (range, channels, mip), so the second layer is an extension of
+// that path rather than a new one.
+//
+// Hover note: hovering across the strip fires a full ReplayOutput redraw per change - a replay
+// round-trip each, which lags so badly over remote connections that users disable the strip.
+// Hover motion should render from a per-output thumbnail cache filled in one batched pass when
+// the event changes, with the full-quality redraw deferred until the hover has settled for
+// ~150ms - strictly no replay work while the cursor is moving.
 ResourcePreview *TextureViewer::UI_CreateThumbnail(ThumbnailStrip *strip)
 {
   ResourcePreview *prev = new ResourcePreview(m_Ctx, m_Output);
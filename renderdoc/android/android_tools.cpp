@@ -311,6 +311,14 @@ Process::ProcessResult execCommand(const std::string &exe, const std::string &ar
   Process::LaunchProcess(exe.c_str(), workDir.c_str(), args.c_str(), true, &result);
   return result;
 }
+// Performance note: every query here pays a full adb process spawn plus the client/daemon
+// handshake, and callers issue them serially - package browsing costs one spawn per package for
+// labels/activities/debuggability. The fixes that fit this layer: batch per-package probes into
+// one `adb shell` invocation emitting delimited records parsed host-side, keep the results in a
+// package index cached per device (invalidated when `pm list packages` output changes), and run
+// the independent per-device probes through the worker pool. A persistent adb connection would
+// mean speaking the adb client protocol on a socket ourselves - worth it only after batching,
+// since one spawn per *batch* is already within the 2s budget.
 Process::ProcessResult adbExecCommand(const std::string &device, const std::string &args,
                                       const std::string &workDir, bool silent)
 {
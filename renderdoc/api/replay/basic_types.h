@@ -402,6 +402,14 @@ public:
     setUsedCount(usedCount + 1);
   }
 
+  void push_back(T &&el)
+  {
+    const size_t lastIdx = size();
+    reserve(size() + 1);
+    new(elems + lastIdx) T(static_cast<T &&>(el));
+    setUsedCount(usedCount + 1);
+  }
+
   void insert(size_t offs, const T *el, size_t count)
   {
     if(el + count >= begin() && end() >= el)
@@ -625,6 +633,22 @@ public:
     assign(in);
   }
 
+  // moves steal the allocation - the capture-load paths construct millions of arrays from
+  // temporaries, and copying each one costs an allocation plus per-element copies
+  rdcarray(rdcarray<T> &&in)
+  {
+    elems = NULL;
+    allocatedCount = usedCount = 0;
+    swap(in);
+  }
+
+  rdcarray &operator=(rdcarray<T> &&in)
+  {
+    // swap - our old contents are destroyed when 'in' goes out of scope
+    swap(in);
+    return *this;
+  }
+
   inline void swap(rdcarray<T> &other)
   {
     std::swap(elems, other.elems);
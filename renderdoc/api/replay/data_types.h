@@ -1429,6 +1429,37 @@ union CounterValue
 DECLARE_REFLECTION_STRUCT(CounterValue);
 
 DOCUMENT("The resulting value from a counter at an event.");
+DOCUMENT(R"(Summary statistics from a CPU comparison of two textures' contents.
+
+Differences are per-pixel: each pixel's difference is the maximum absolute per-channel
+difference after both textures are fetched as RGBA 32-bit float.
+)");
+struct TextureComparison
+{
+  DOCUMENT("");
+  TextureComparison() = default;
+  TextureComparison(const TextureComparison &) = default;
+
+  DOCUMENT("The number of pixels compared.");
+  uint64_t pixelsCompared = 0;
+
+  DOCUMENT("The number of pixels whose difference exceeded the tolerance.");
+  uint64_t pixelsDiffering = 0;
+
+  DOCUMENT("The largest per-pixel difference.");
+  double maxDifference = 0.0;
+
+  DOCUMENT("The mean per-pixel difference.");
+  double meanDifference = 0.0;
+
+  DOCUMENT(R"(Counts of per-pixel differences bucketed linearly over ``[0, 1)`` in 16 steps, with
+differences of 1.0 or more counted in the last bucket.
+)");
+  rdcarray<uint64_t> histogram;
+};
+
+DECLARE_REFLECTION_STRUCT(TextureComparison);
+
 struct CounterResult
 {
 #if defined(SWIG) || defined(SWIGPYTHON)
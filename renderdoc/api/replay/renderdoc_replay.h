@@ -595,6 +595,14 @@ DECLARE_REFLECTION_STRUCT(ExecuteResult);
 // here and document them immediately below. They can be linked to from anywhere by name.
 typedef std::function<bool()> RENDERDOC_KillCallback;
 typedef std::function<void(float)> RENDERDOC_ProgressCallback;
+
+DOCUMENT(R"(A callback for visiting frame capture chunks. Receives each chunk's metadata in order.
+
+:param SDChunkMetaData meta: The chunk's metadata.
+:return: ``True`` to continue visiting, ``False`` to stop early.
+:rtype: ``bool``
+)");
+typedef std::function<bool(const SDChunkMetaData &)> RENDERDOC_ChunkVisitorCallback;
 typedef std::function<WindowingData(bool, const rdcarray<WindowingSystem> &)> RENDERDOC_PreviewWindowCallback;
 
 DOCUMENT(R"(A stateful output handle that contains the current configuration for one particular view
@@ -1288,6 +1296,21 @@ sample 0, etc.
 )");
   virtual bytebuf GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip) = 0;
 
+  DOCUMENT(R"(Compares the contents of two textures on the CPU, for formats or configurations the
+GPU diff path can't alias. Both textures are fetched as RGBA 32-bit float (top mip, first slice)
+and compared per-pixel; a pixel counts as differing when any channel's absolute difference exceeds
+the tolerance. The textures must have matching dimensions.
+
+:param ResourceId texA: The first texture.
+:param ResourceId texB: The second texture.
+:param float tolerance: The per-channel absolute difference above which a pixel counts as
+  differing.
+:return: Summary statistics of the comparison. 0 pixels compared indicates a failure, e.g.
+  mismatched dimensions or an invalid texture.
+:rtype: TextureComparison
+)");
+  virtual TextureComparison CompareTextures(ResourceId texA, ResourceId texB, float tolerance) = 0;
+
   static const uint32_t NoPreference = ~0U;
 
 protected:
@@ -1462,6 +1485,22 @@ or name).
 )");
   virtual bool WriteSection(const SectionProperties &props, const bytebuf &contents) = 0;
 
+  DOCUMENT(R"(Visits the metadata of each chunk in the frame capture section in order, streaming
+from disk without building the structured representation - constant memory regardless of capture
+size, for analysis tools scanning large captures.
+
+Chunk contents are not decoded; use :meth:`GetStructuredData` when values are needed.
+
+:param ChunkVisitorCallback visitor: The callback invoked with each chunk's
+  :class:`SDChunkMetaData`. Returning ``False`` stops the visit early.
+:param List[int] chunkFilter: If non-empty, only chunks whose ID is in this list are passed to the
+  callback.
+:return: The number of chunks passed to the callback.
+:rtype: ``int``
+)");
+  virtual uint64_t VisitFrameChunks(RENDERDOC_ChunkVisitorCallback visitor,
+                                    const rdcarray<uint32_t> &chunkFilter) = 0;
+
   DOCUMENT(R"(Query if callstacks are available.
 
 :return: ``True`` if any callstacks are available, ``False`` otherwise.
@@ -770,6 +770,9 @@ rdcstr DoStringise(const GPUCounter &el)
   if(IsIntelCounter(el))
     return "Intel Counter " + ToStr((uint32_t)el);
 
+  if(IsDerivedCounter(el))
+    return "Derived Counter " + ToStr((uint32_t)el);
+
   BEGIN_ENUM_STRINGISE(GPUCounter)
   {
     STRINGISE_ENUM_CLASS(EventGPUDuration);
@@ -915,6 +918,8 @@ rdcstr DoStringise(const SectionType &el)
     STRINGISE_ENUM_CLASS_NAMED(ResourceRenames, "renderdoc/ui/resrenames");
     STRINGISE_ENUM_CLASS_NAMED(AMDRGPProfile, "amd/rgp/profile");
     STRINGISE_ENUM_CLASS_NAMED(ExtendedThumbnail, "renderdoc/internal/exthumb");
+    STRINGISE_ENUM_CLASS_NAMED(FrameStats, "renderdoc/internal/framestats");
+    STRINGISE_ENUM_CLASS_NAMED(ResourceBloom, "renderdoc/internal/resbloom");
   }
   END_ENUM_STRINGISE();
 }
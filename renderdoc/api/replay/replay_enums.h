@@ -83,6 +83,13 @@ version of RenderDoc that addes a new section type. They should be considered eq
   lossless.
 
   The name for this section will be "renderdoc/internal/exthumb".
+
+.. data:: FrameStats
+
+  This section contains lightweight statistics about the captured frame, written at capture
+  time, so archive tooling can triage captures without creating a replay.
+
+  The name for this section will be "renderdoc/internal/framestats".
 )");
 enum class SectionType : uint32_t
 {
@@ -95,6 +102,8 @@ enum class SectionType : uint32_t
   ResourceRenames,
   AMDRGPProfile,
   ExtendedThumbnail,
+  FrameStats,
+  ResourceBloom,
   Count,
 };
 
@@ -2965,6 +2974,14 @@ enum class GPUCounter : uint32_t
   LastIntel = FirstNvidia - 1,
 
   LastNvidia = 4000000,
+
+  // derived counters, computed in-core from the generic counters above rather than fetched from
+  // the driver or an IHV plugin
+  FirstDerived = 5000000,
+  VertexCacheReuse = FirstDerived,
+  DepthTestEfficiency,
+  PrimitiveSurvivalRate,
+  LastDerived,
 };
 
 ITERABLE_OPERATORS(GPUCounter);
@@ -3014,6 +3031,17 @@ inline constexpr bool IsNvidiaCounter(GPUCounter c)
   return c >= GPUCounter::FirstNvidia && c <= GPUCounter::LastNvidia;
 }
 
+DOCUMENT(R"(Check whether or not this is a derived counter, computed from other counters.
+
+:param GPUCounter c: The counter.
+:return: ``True`` if it is a derived counter, ``False`` if it's not.
+:rtype: ``bool``
+)");
+inline constexpr bool IsDerivedCounter(GPUCounter c)
+{
+  return c >= GPUCounter::FirstDerived && c < GPUCounter::LastDerived;
+}
+
 DOCUMENT(R"(The unit that GPU counter data is returned in.
 
 .. data:: Absolute
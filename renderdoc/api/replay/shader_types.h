@@ -468,6 +468,13 @@ DOCUMENT(R"(This stores the whole state of a shader's execution from start to fi
 individual debugging step along the way, as well as the immutable global constant values that do not
 change with shader execution.
 )");
+// Memory/API note: materialising every register of every step makes long-looping shaders
+// produce multi-GB traces, which is fatal over remote sessions. The planned evolution is a
+// summary (instruction count, touched registers, source mapping) plus paged access, with the
+// interpreters emitting per-step register deltas instead of full snapshots - the ShaderViewer
+// steps linearly, so pages can be reconstructed from deltas on demand and evicted behind the
+// cursor. That's a breaking change to this public type and to every debugger backend, so it
+// needs its own API revision rather than growing fields here.
 struct ShaderDebugTrace
 {
   DOCUMENT("");
@@ -243,6 +243,12 @@ conservative size estimate was used on creation to avoid seeking to fix-up the s
   DOCUMENT("The ID of the thread where this chunk was recorded.");
   uint64_t threadID = 0;
 
+  DOCUMENT(R"(The byte offset of this chunk's header from the start of the stream it was read
+from, when it was created by reading a capture. Tools can use it to seek back to a chunk and
+re-read or lazily materialise its contents without walking the whole section.
+)");
+  uint64_t byteOffset = 0;
+
   DOCUMENT(R"(The duration in microseconds that this chunk took. This is the time for the actual
 work, not the serialising.
 Since 0 is a possible value for this (for extremely fast calls), -1 is the invalid/not present value.
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "common/common.h"
+
+// a plain bloom filter over 64-bit values, used to build compact membership indexes written
+// into capture files (e.g. the set of ResourceIds referenced in the frame). Queries answer
+// "definitely not present" or "possibly present" - sized for roughly 1% false positives at the
+// expected element count.
+struct BloomFilter
+{
+  void Init(uint64_t expectedCount)
+  {
+    // ~9.6 bits per element and 7 hashes give ~1% false positives; round bits up to whole bytes
+    // and keep a sane floor so tiny sets still hash across a few words
+    uint64_t numBits = RDCMAX((uint64_t)64, (expectedCount * 96 + 9) / 10);
+
+    bits.resize(size_t((numBits + 7) / 8));
+    numHashes = 7;
+  }
+
+  void Add(uint64_t value)
+  {
+    uint64_t h1 = Hash(value, 0xcbf29ce484222325ULL);
+    uint64_t h2 = Hash(value, 0x84222325cbf29ce4ULL);
+
+    // standard double hashing: bit index i is h1 + i*h2
+    for(uint32_t i = 0; i < numHashes; i++)
+    {
+      uint64_t bit = (h1 + i * h2) % (bits.size() * 8);
+      bits[size_t(bit / 8)] |= byte(1 << (bit % 8));
+    }
+  }
+
+  bool PossiblyContains(uint64_t value) const
+  {
+    if(bits.empty())
+      return false;
+
+    uint64_t h1 = Hash(value, 0xcbf29ce484222325ULL);
+    uint64_t h2 = Hash(value, 0x84222325cbf29ce4ULL);
+
+    for(uint32_t i = 0; i < numHashes; i++)
+    {
+      uint64_t bit = (h1 + i * h2) % (bits.size() * 8);
+      if((bits[size_t(bit / 8)] & byte(1 << (bit % 8))) == 0)
+        return false;
+    }
+
+    return true;
+  }
+
+  std::vector<byte> bits;
+  uint32_t numHashes = 0;
+
+private:
+  static uint64_t Hash(uint64_t value, uint64_t seed)
+  {
+    // FNV-1a over the value bytes, seeded so the two hash streams are independent
+    uint64_t hash = seed;
+
+    for(size_t b = 0; b < sizeof(value); b++)
+    {
+      hash ^= (value >> (b * 8)) & 0xff;
+      hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+  }
+};
@@ -0,0 +1,75 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "bloom.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+
+TEST_CASE("Test bloom filter membership", "[bloom]")
+{
+  SECTION("added values are always possibly present")
+  {
+    BloomFilter bloom;
+    bloom.Init(1000);
+
+    for(uint64_t i = 0; i < 1000; i++)
+      bloom.Add(i * 0x9E3779B97F4A7C15ULL + 3);
+
+    for(uint64_t i = 0; i < 1000; i++)
+      CHECK(bloom.PossiblyContains(i * 0x9E3779B97F4A7C15ULL + 3));
+  }
+
+  SECTION("false positive rate is in the expected ballpark")
+  {
+    BloomFilter bloom;
+    bloom.Init(1000);
+
+    for(uint64_t i = 0; i < 1000; i++)
+      bloom.Add(i);
+
+    uint32_t falsePositives = 0;
+    for(uint64_t i = 1000; i < 11000; i++)
+      if(bloom.PossiblyContains(i))
+        falsePositives++;
+
+    // sized for ~1%, allow a wide margin so the test isn't sensitive to hash quirks
+    CHECK(falsePositives < 500);
+  }
+
+  SECTION("empty filter contains nothing")
+  {
+    BloomFilter bloom;
+
+    CHECK_FALSE(bloom.PossiblyContains(42));
+
+    bloom.Init(10);
+
+    CHECK_FALSE(bloom.PossiblyContains(42));
+  }
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -0,0 +1,186 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "api/replay/renderdoc_replay.h"
+#include "common/common.h"
+
+// a flat page table keyed by ResourceId, for the replay-side id remapping tables. Resource ids
+// are allocated monotonically so live and original ids are dense from 1 - a paged flat array
+// gives O(1) indexing on the per-chunk-argument hot path where a std::map pays a pointer-chasing
+// tree walk per lookup, and dropping the pages frees the whole table in O(pages) on close.
+// Values are default-constructed; occupancy is tracked separately so T needs no sentinel.
+template <typename T>
+struct IdPageTable
+{
+  static const uint64_t PageShift = 12;
+  static const uint64_t PageSize = 1ULL << PageShift;    // 4096 entries per page
+
+  ~IdPageTable() { clear(); }
+  bool empty() const { return m_Count == 0; }
+  size_t size() const { return m_Count; }
+  bool has(ResourceId id) const { return find(id) != NULL; }
+  const T *find(ResourceId id) const
+  {
+    uint64_t value = IdValue(id);
+    const Page *page = GetPage(value);
+
+    if(page == NULL || !Occupied(*page, value & (PageSize - 1)))
+      return NULL;
+
+    return &page->values[value & (PageSize - 1)];
+  }
+
+  T *find(ResourceId id)
+  {
+    return const_cast<T *>(((const IdPageTable *)this)->find(id));
+  }
+
+  // inserts a default-constructed value if the id isn't present
+  T &operator[](ResourceId id)
+  {
+    uint64_t value = IdValue(id);
+    Page *page = GetOrAllocPage(value);
+
+    uint64_t slot = value & (PageSize - 1);
+
+    if(!Occupied(*page, slot))
+    {
+      page->occupied[slot / 64] |= 1ULL << (slot % 64);
+      page->values[slot] = T();
+      page->count++;
+      m_Count++;
+    }
+
+    return page->values[slot];
+  }
+
+  void erase(ResourceId id)
+  {
+    uint64_t value = IdValue(id);
+    Page *page = GetPage(value);
+
+    uint64_t slot = value & (PageSize - 1);
+
+    if(page && Occupied(*page, slot))
+    {
+      page->occupied[slot / 64] &= ~(1ULL << (slot % 64));
+      page->values[slot] = T();
+      page->count--;
+      m_Count--;
+    }
+  }
+
+  // fetches any one present entry, for drain loops that may mutate the table between steps
+  bool getFirst(ResourceId &id, T &value) const
+  {
+    for(size_t p = 0; p < m_Pages.size(); p++)
+    {
+      const Page *page = m_Pages[p];
+
+      if(page == NULL || page->count == 0)
+        continue;
+
+      for(uint64_t slot = 0; slot < PageSize; slot++)
+      {
+        if(Occupied(*page, slot))
+        {
+          uint64_t raw = (uint64_t(p) << PageShift) | slot;
+          memcpy(&id, &raw, sizeof(id));
+          value = page->values[slot];
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  void clear()
+  {
+    for(Page *page : m_Pages)
+      delete page;
+
+    m_Pages.clear();
+    m_Count = 0;
+  }
+
+private:
+  struct Page
+  {
+    T values[PageSize];
+    uint64_t occupied[PageSize / 64] = {};
+    uint32_t count = 0;
+  };
+
+  static uint64_t IdValue(ResourceId id)
+  {
+    RDCCOMPILE_ASSERT(sizeof(ResourceId) == sizeof(uint64_t), "ResourceId is wider than expected");
+
+    uint64_t value = 0;
+    memcpy(&value, &id, sizeof(value));
+    return value;
+  }
+
+  static bool Occupied(const Page &page, uint64_t slot)
+  {
+    return (page.occupied[slot / 64] & (1ULL << (slot % 64))) != 0;
+  }
+
+  const Page *GetPage(uint64_t value) const
+  {
+    uint64_t pageIdx = value >> PageShift;
+
+    if(pageIdx >= m_Pages.size())
+      return NULL;
+
+    return m_Pages[pageIdx];
+  }
+
+  Page *GetPage(uint64_t value)
+  {
+    return const_cast<Page *>(((const IdPageTable *)this)->GetPage(value));
+  }
+
+  Page *GetOrAllocPage(uint64_t value)
+  {
+    uint64_t pageIdx = value >> PageShift;
+
+    if(pageIdx >= m_Pages.size())
+      m_Pages.resize(size_t(pageIdx + 1), NULL);
+
+    if(m_Pages[size_t(pageIdx)] == NULL)
+      m_Pages[size_t(pageIdx)] = new Page;
+
+    return m_Pages[size_t(pageIdx)];
+  }
+
+  std::vector<Page *> m_Pages;
+  size_t m_Count = 0;
+};
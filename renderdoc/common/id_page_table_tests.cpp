@@ -0,0 +1,104 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "id_page_table.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+
+TEST_CASE("Test id page table", "[idpagetable]")
+{
+  SECTION("insert, lookup, erase")
+  {
+    IdPageTable<uint32_t> table;
+
+    CHECK(table.empty());
+
+    ResourceId a = ResourceIDGen::GetNewUniqueID();
+    ResourceId b = ResourceIDGen::GetNewUniqueID();
+
+    table[a] = 111;
+    table[b] = 222;
+
+    CHECK(table.size() == 2);
+    CHECK(table.has(a));
+    REQUIRE(table.find(a));
+    CHECK(*table.find(a) == 111);
+    CHECK(*table.find(b) == 222);
+    CHECK_FALSE(table.has(ResourceId()));
+    CHECK(table.find(ResourceIDGen::GetNewUniqueID()) == NULL);
+
+    // operator[] on an existing id must not reset the value
+    CHECK(table[a] == 111);
+    CHECK(table.size() == 2);
+
+    table.erase(a);
+
+    CHECK_FALSE(table.has(a));
+    CHECK(table.has(b));
+    CHECK(table.size() == 1);
+
+    // erasing twice is harmless
+    table.erase(a);
+    CHECK(table.size() == 1);
+
+    table.clear();
+    CHECK(table.empty());
+  }
+
+  SECTION("spans page boundaries and drains via getFirst")
+  {
+    IdPageTable<uint64_t> table;
+
+    std::vector<ResourceId> ids;
+    for(int i = 0; i < 10000; i++)
+      ids.push_back(ResourceIDGen::GetNewUniqueID());
+
+    for(size_t i = 0; i < ids.size(); i++)
+      table[ids[i]] = uint64_t(i) * 3 + 1;
+
+    REQUIRE(table.size() == ids.size());
+
+    for(size_t i = 0; i < ids.size(); i++)
+      REQUIRE(*table.find(ids[i]) == uint64_t(i) * 3 + 1);
+
+    // drain the whole table through the shutdown-loop pattern
+    size_t drained = 0;
+    while(!table.empty())
+    {
+      ResourceId id;
+      uint64_t value = 0;
+      REQUIRE(table.getFirst(id, value));
+      CHECK(value != 0);
+      table.erase(id);
+      drained++;
+    }
+
+    CHECK(drained == ids.size());
+  }
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
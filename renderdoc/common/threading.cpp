@@ -0,0 +1,183 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "threading.h"
+
+namespace Threading
+{
+namespace
+{
+struct JobSystem
+{
+  std::vector<ThreadHandle> threads;
+
+  SemaphoreHandle workSemaphore = NULL;
+  SemaphoreHandle doneSemaphore = NULL;
+
+  // the currently executing job. Only one ParallelFor runs at a time, serialised by the job
+  // lock, so these are only written while no worker is awake.
+  const std::function<void(uint64_t, uint64_t)> *func = NULL;
+  uint64_t count = 0;
+  uint64_t grain = 1;
+
+  // shared cursor the threads claim chunks from
+  volatile int64_t cursor = 0;
+
+  // workers still processing the current job
+  volatile int32_t remaining = 0;
+
+  volatile int32_t kill = 0;
+};
+
+JobSystem *jobSystem = NULL;
+
+// set while this thread is executing chunks of a job, so that a nested ParallelFor from inside a
+// chunk function degrades to a serial loop instead of deadlocking on the job lock.
+thread_local bool insideJob = false;
+
+CriticalSection &JobLock()
+{
+  static CriticalSection lock;
+  return lock;
+}
+
+// claim and process chunks of the current job until the range is exhausted
+void RunChunks(JobSystem *js)
+{
+  insideJob = true;
+
+  for(;;)
+  {
+    // ExchAdd64 returns the post-add value on all platforms, so this claims
+    // [chunkEnd - grain, chunkEnd)
+    int64_t chunkEnd = Atomic::ExchAdd64(&js->cursor, int64_t(js->grain));
+    int64_t chunkStart = chunkEnd - int64_t(js->grain);
+
+    RDCASSERT(chunkStart >= 0);
+
+    if(chunkStart >= int64_t(js->count))
+      break;
+
+    (*js->func)(uint64_t(chunkStart), RDCMIN(uint64_t(chunkEnd), js->count));
+  }
+
+  insideJob = false;
+}
+
+void WorkerLoop(JobSystem *js)
+{
+  for(;;)
+  {
+    SemaphoreWait(js->workSemaphore);
+
+    if(js->kill)
+      break;
+
+    RunChunks(js);
+
+    // the last worker to finish signals the submitting thread
+    if(Atomic::Dec32(&js->remaining) == 0)
+      SemaphorePost(js->doneSemaphore, 1);
+  }
+}
+};
+
+// Topology note: workers are placed wherever the scheduler likes. On multi-socket analysis
+// machines that costs real throughput - decompression output consumed by a chunk processor on
+// the other NUMA node, init-state buffers touched cross-node. Fixing it needs topology
+// enumeration in the OS layer (cores, SMT siblings, NUMA nodes - sysfs on Linux,
+// GetLogicalProcessorInformationEx on Windows), a SetThreadAffinity alongside CreateThread, and
+// then partitioning here so a chunk's worker is on the node that owns the data. Until the
+// enumeration exists, pinning would be guesswork.
+void ParallelFor(uint64_t count, const std::function<void(uint64_t first, uint64_t last)> &func,
+                 uint64_t serialThreshold)
+{
+  if(count == 0)
+    return;
+
+  uint32_t poolSize = RDCMIN(NumberOfCores(), 16U);
+
+  if(count < serialThreshold || poolSize <= 1 || insideJob)
+  {
+    func(0, count);
+    return;
+  }
+
+  SCOPED_LOCK(JobLock());
+
+  if(jobSystem == NULL)
+  {
+    jobSystem = new JobSystem;
+    jobSystem->workSemaphore = SemaphoreCreate();
+    jobSystem->doneSemaphore = SemaphoreCreate();
+
+    // the calling thread processes chunks too, so spawn one fewer worker than cores
+    for(uint32_t i = 0; i < poolSize - 1; i++)
+      jobSystem->threads.push_back(CreateThread([]() { WorkerLoop(jobSystem); }));
+  }
+
+  JobSystem *js = jobSystem;
+
+  uint32_t numWorkers = (uint32_t)js->threads.size();
+
+  js->func = &func;
+  js->count = count;
+  // hand out work in chunks well below a per-thread split, so threads that finish early pull more
+  js->grain = RDCMAX((uint64_t)1, count / (uint64_t(numWorkers + 1) * 8));
+  js->cursor = 0;
+  js->remaining = (int32_t)numWorkers;
+
+  SemaphorePost(js->workSemaphore, numWorkers);
+
+  // chew on the range ourselves as well rather than just sleeping
+  RunChunks(js);
+
+  // wait for the workers to drain their last chunks
+  SemaphoreWait(js->doneSemaphore);
+
+  js->func = NULL;
+}
+
+void ShutdownJobSystem()
+{
+  SCOPED_LOCK(JobLock());
+
+  if(jobSystem == NULL)
+    return;
+
+  Atomic::CmpExch32(&jobSystem->kill, 0, 1);
+  SemaphorePost(jobSystem->workSemaphore, (uint32_t)jobSystem->threads.size());
+
+  for(ThreadHandle thread : jobSystem->threads)
+  {
+    JoinThread(thread);
+    CloseThread(thread);
+  }
+
+  SemaphoreDestroy(jobSystem->workSemaphore);
+  SemaphoreDestroy(jobSystem->doneSemaphore);
+
+  SAFE_DELETE(jobSystem);
+}
+};
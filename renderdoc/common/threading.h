@@ -89,6 +89,20 @@ public:
 private:
   SpinLock *m_Spin;
 };
+
+// Runs func(first, last) over disjoint subranges of [0, count) on a shared pool of worker
+// threads plus the calling thread, blocking until the whole range is processed. Work is handed
+// out in small chunks from a shared cursor, so threads that finish early keep pulling more and
+// uneven workloads balance dynamically. Small counts run directly on the calling thread, so
+// this is safe to use without checking the size first. Nested calls from inside a chunk
+// function run serially rather than going back to the pool.
+// serialThreshold can be lowered for expensive per-item work, where even a handful of items are
+// worth distributing.
+void ParallelFor(uint64_t count, const std::function<void(uint64_t first, uint64_t last)> &func,
+                 uint64_t serialThreshold = 4096);
+
+// tears down ParallelFor's worker pool. Called once at module shutdown.
+void ShutdownJobSystem();
 };
 
 #define SCOPED_LOCK(cs) Threading::ScopedLock CONCAT(scopedlock, __LINE__)(&cs);
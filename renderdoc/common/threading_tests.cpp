@@ -71,4 +71,85 @@ TEST_CASE("Test spin lock", "[threading]")
   CHECK(finalValue == value);
 }
 
+TEST_CASE("Test atomic return-value contract", "[threading]")
+{
+  // the chunk-claim loops (ParallelFor, the pipelined compressor tickets) compute their claimed
+  // ranges from the returned value, so the atomics must return the post-operation value on
+  // every platform - a divergence here silently shifts every claimed range by one grain
+  volatile int64_t v = 10;
+
+  CHECK(Atomic::ExchAdd64(&v, 5) == 15);
+  CHECK(v == 15);
+  CHECK(Atomic::Inc64(&v) == 16);
+  CHECK(Atomic::Dec64(&v) == 15);
+
+  volatile int32_t w = 3;
+
+  CHECK(Atomic::Inc32(&w) == 4);
+  CHECK(Atomic::Dec32(&w) == 3);
+
+  // CmpExch32 returns the original value
+  CHECK(Atomic::CmpExch32(&w, 3, 7) == 3);
+  CHECK(w == 7);
+  CHECK(Atomic::CmpExch32(&w, 3, 9) == 7);
+  CHECK(w == 7);
+};
+
+TEST_CASE("Test ParallelFor", "[threading]")
+{
+  // large enough to go wide onto the worker pool, with the serial threshold forced low so any
+  // machine with the cores drives the parallel path. Every handed-out range must stay inside
+  // [0, count) - a bad chunk claim shows up here as an out-of-bounds or inverted range.
+  std::vector<uint32_t> output(1024 * 1024);
+
+  volatile int32_t badRanges = 0;
+
+  Threading::ParallelFor(output.size(),
+                         [&output, &badRanges](uint64_t first, uint64_t last) {
+                           if(first > last || last > output.size())
+                           {
+                             Atomic::Inc32(&badRanges);
+                             return;
+                           }
+
+                           for(uint64_t i = first; i < last; i++)
+                             output[(size_t)i] = uint32_t(i) * 3;
+                         },
+                         1);
+
+  CHECK(badRanges == 0);
+
+  bool correct = true;
+  for(size_t i = 0; i < output.size(); i++)
+    correct &= (output[i] == uint32_t(i) * 3);
+
+  CHECK(correct);
+
+  // run again to check the pool is reusable
+  Threading::ParallelFor(output.size(), [&output](uint64_t first, uint64_t last) {
+    for(uint64_t i = first; i < last; i++)
+      output[(size_t)i] += 1;
+  });
+
+  correct = true;
+  for(size_t i = 0; i < output.size(); i++)
+    correct &= (output[i] == uint32_t(i) * 3 + 1);
+
+  CHECK(correct);
+
+  // small ranges take the serial path
+  std::vector<uint32_t> small(7, 0);
+
+  Threading::ParallelFor(small.size(), [&small](uint64_t first, uint64_t last) {
+    for(uint64_t i = first; i < last; i++)
+      small[(size_t)i] = 100 + uint32_t(i);
+  });
+
+  for(size_t i = 0; i < small.size(); i++)
+    CHECK(small[i] == 100 + uint32_t(i));
+
+  // empty ranges are a no-op
+  Threading::ParallelFor(0, [](uint64_t, uint64_t) { FAIL("func called for empty range"); });
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
\ No newline at end of file
@@ -55,8 +55,37 @@ class WrappingPool
 public:
   void *Allocate()
   {
+    // per-thread magazine: alloc/free usually hit this small cache, and the shared lock is only
+    // taken to exchange a batch of slots - transient state objects created in bursts stop
+    // contending on every allocation
+    Magazine &mag = GetMagazine();
+
+    if(mag.count > 0)
+      return mag.slots[--mag.count];
+
     SCOPED_LOCK(m_Lock);
 
+    // refill half a magazine while we hold the lock, so the next allocations are lock-free
+    while(mag.count < MagazineSize / 2)
+    {
+      void *slot = AllocateFromPools();
+
+      if(slot == NULL)
+        break;
+
+      mag.slots[mag.count++] = slot;
+    }
+
+    if(mag.count > 0)
+      return mag.slots[--mag.count];
+
+    return NULL;
+  }
+
+private:
+  // must hold m_Lock
+  void *AllocateFromPools()
+  {
     // try and allocate from immediate pool
     void *ret = m_ImmediatePool.Allocate();
     if(ret != NULL)
@@ -89,6 +118,7 @@ public:
     return m_AdditionalPools.back()->Allocate();
   }
 
+public:
   bool IsAlloc(const void *p)
   {
     // we can check the immediate pool without locking
@@ -114,8 +144,41 @@ public:
     if(p == NULL)
       return;
 
+    // reject pointers that aren't ours before they can enter the magazine and be recycled as
+    // slots of this type - keeps the wrong-pool deletion error loud and immediate
+    if(!IsAlloc(p))
+    {
+#if ENABLED(INCLUDE_TYPE_NAMES)
+      RDCERR("Resource being deleted through wrong pool - 0x%p not a member of %s", p,
+             GetTypeName<WrapType>::Name());
+#else
+      RDCERR("Resource being deleted through wrong pool - 0x%p not a member of 0x%p", p,
+             &m_ImmediatePool.items[0]);
+#endif
+      return;
+    }
+
+    Magazine &mag = GetMagazine();
+
+    if(mag.count < MagazineSize)
+    {
+      mag.slots[mag.count++] = p;
+      return;
+    }
+
     SCOPED_LOCK(m_Lock);
 
+    // magazine is full - return half of it to the pools along with this slot
+    while(mag.count > MagazineSize / 2)
+      DeallocateToPools(mag.slots[--mag.count]);
+
+    DeallocateToPools(p);
+  }
+
+private:
+  // must hold m_Lock
+  void DeallocateToPools(void *p)
+  {
     // try immediate pool
     if(m_ImmediatePool.IsAlloc(p))
     {
@@ -145,11 +208,42 @@ public:
 #endif
   }
 
+public:
   static const size_t AllocCount = PoolCount;
   static const size_t AllocMaxByteSize = MaxPoolByteSize;
   static const size_t AllocByteSize;
 
 private:
+  static const size_t MagazineSize = 32;
+
+  struct Magazine
+  {
+    ~Magazine()
+    {
+      // return anything cached when the thread exits, so slots aren't stranded
+      if(owner)
+      {
+        SCOPED_LOCK(owner->m_Lock);
+
+        while(count > 0)
+          owner->DeallocateToPools(slots[--count]);
+      }
+    }
+
+    WrappingPool *owner = NULL;
+    void *slots[MagazineSize];
+    size_t count = 0;
+  };
+
+  Magazine &GetMagazine()
+  {
+    static thread_local Magazine magazine;
+
+    magazine.owner = this;
+
+    return magazine;
+  }
+
   WrappingPool()
   {
 #if ENABLED(INCLUDE_TYPE_NAMES)
@@ -0,0 +1,112 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "wrapped_pool.h"
+#include "threading.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include <algorithm>
+#include <set>
+#include <vector>
+#include "3rdparty/catch/catch.hpp"
+
+struct PooledTestObject
+{
+  uint64_t payload[4];
+
+  ALLOCATE_WITH_WRAPPED_POOL(PooledTestObject);
+};
+
+WRAPPED_POOL_INST(PooledTestObject);
+
+TEST_CASE("Test wrapped pool magazine allocation", "[wrapped_pool]")
+{
+  // single threaded: allocations are unique, identified by IsAlloc, and slots recycle through
+  // the per-thread magazine
+  {
+    std::set<PooledTestObject *> live;
+
+    for(int i = 0; i < 1000; i++)
+    {
+      PooledTestObject *obj = new PooledTestObject();
+
+      CHECK(PooledTestObject::IsAlloc(obj));
+      CHECK((live.find(obj) == live.end()));
+
+      live.insert(obj);
+    }
+
+    for(PooledTestObject *obj : live)
+      delete obj;
+  }
+
+  // multi threaded: cross-thread churn, including objects freed on a different thread to the
+  // one that allocated them
+  {
+    std::vector<PooledTestObject *> handoff[8];
+    std::vector<Threading::ThreadHandle> threads;
+
+    Threading::CriticalSection lock;
+
+    for(int t = 0; t < 8; t++)
+    {
+      threads.push_back(Threading::CreateThread([t, &handoff, &lock]() {
+        std::vector<PooledTestObject *> mine;
+
+        for(int i = 0; i < 500; i++)
+          mine.push_back(new PooledTestObject());
+
+        {
+          SCOPED_LOCK(lock);
+          handoff[(t + 1) % 8] = mine;
+        }
+      }));
+    }
+
+    for(Threading::ThreadHandle t : threads)
+    {
+      Threading::JoinThread(t);
+      Threading::CloseThread(t);
+    }
+
+    std::set<PooledTestObject *> all;
+
+    for(int t = 0; t < 8; t++)
+      for(PooledTestObject *obj : handoff[t])
+      {
+        CHECK(PooledTestObject::IsAlloc(obj));
+        all.insert(obj);
+      }
+
+    // no slot was handed to two threads
+    CHECK(all.size() == 8 * 500);
+
+    // free on this thread, not the allocating ones
+    for(PooledTestObject *obj : all)
+      delete obj;
+  }
+};
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -578,6 +578,33 @@ public:
 
   string GetOverlayText(RDCDriver driver, uint32_t frameNumber, int flags);
 
+  // blocks for up to the timeout, waking immediately when a new capture is registered - lets
+  // the target control thread push NewCapture notifications without polling latency
+  void WaitForCaptureTick(uint32_t timeoutMS)
+  {
+    Threading::SemaphoreTimedWait(m_CaptureKickSemaphore, timeoutMS);
+  }
+
+  // last frame's recording statistics, drained from the chunk counters once per Tick
+  uint64_t m_FrameChunks = 0;
+  uint64_t m_FrameChunkBytes = 0;
+
+  // CPU-side duration of a queue submission made while a frame capture was active, reported by
+  // the driver's submit wrapper and written into the FrameStats section at capture finish
+  void AddFrameSubmitTiming(uint64_t durationMicro);
+
+  // resources the driver saw referenced in the captured frame, folded into the ResourceBloom
+  // membership index section at capture finish
+  void AddFrameReferencedResource(ResourceId id);
+
+  Threading::SemaphoreHandle m_CaptureKickSemaphore = NULL;
+
+  Threading::CriticalSection m_SubmitTimingLock;
+  std::vector<uint64_t> m_FrameSubmitTimings;
+
+  Threading::CriticalSection m_FrameResourceLock;
+  std::vector<ResourceId> m_FrameResourceIds;
+
   void CycleActiveWindow();
   uint32_t GetCapturableWindowCount() { return (uint32_t)m_WindowFrameCapturers.size(); }
 private:
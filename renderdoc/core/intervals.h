@@ -25,6 +25,7 @@
 
 #include <algorithm>
 #include <map>
+#include <vector>
 #include "common/common.h"
 
 template <typename T>
@@ -246,6 +247,55 @@ public:
       i->mergeLeft();
   }
 
+  // A (range, value) element of a sorted update run for updateSortedRun.
+  struct RangeValue
+  {
+    uint64_t start;
+    uint64_t finish;
+    T value;
+  };
+
+  // Applies a run of updates whose ranges are sorted ascending and non-overlapping,
+  // equivalent to calling update() for each element but advancing a single cursor through the
+  // map instead of paying a root-to-leaf search per range - one sweep for the whole run. The
+  // memory diff paths merge thousands of dirty ranges at a time, where the repeated searches
+  // dominate update()'s cost.
+  template <typename Compose>
+  void updateSortedRun(const std::vector<RangeValue> &run, Compose comp)
+  {
+    iterator i = begin();
+
+    for(const RangeValue &r : run)
+    {
+      if(r.finish <= r.start)
+        continue;
+
+      // skip intervals entirely before this range; the run is sorted so the cursor only ever
+      // moves forward
+      while(i != end() && i->finish() <= r.start)
+        i++;
+
+      if(i == end())
+        break;
+
+      i->split(r.start);
+
+      for(; i != end() && i->start() < r.finish; i++)
+      {
+        if(i->finish() > r.finish)
+        {
+          i->split(r.finish);
+          i--;
+        }
+        i->setValue(comp(i->value(), r.value));
+        i->mergeLeft();
+      }
+
+      if(i != end())
+        i->mergeLeft();
+    }
+  }
+
   // Update `this` by composing the value of each interval with the value of the
   // corresponding interval in `other`.
   // If the intervals in `this` and `other` do not line up, then the intervals in
@@ -30,7 +30,9 @@
 #include "3rdparty/catch/catch.hpp"
 
 #include <stdint.h>
+#include <stdlib.h>
 #include <vector>
+#include "common/timing.h"
 
 struct Interval
 {
@@ -440,4 +442,118 @@ TEST_CASE("Test Intervals type", "[intervals]")
   };
 };
 
+
+TEST_CASE("Test Intervals sorted-run update", "[intervals]")
+{
+  auto maxComp = [](uint64_t x, uint64_t y) -> uint64_t { return std::max(x, y); };
+
+  SECTION("equivalent to repeated update")
+  {
+    srand(77);
+
+    for(int trial = 0; trial < 50; trial++)
+    {
+      // seed both sides with the same random base intervals
+      Intervals<uint64_t> viaUpdate, viaRun;
+
+      for(int i = 0; i < 20; i++)
+      {
+        uint64_t start = uint64_t(rand() % 5000);
+        uint64_t finish = start + 1 + uint64_t(rand() % 200);
+        uint64_t value = uint64_t(rand() % 4);
+
+        viaUpdate.update(start, finish, value, maxComp);
+        viaRun.update(start, finish, value, maxComp);
+      }
+
+      // generate a sorted non-overlapping run
+      std::vector<Intervals<uint64_t>::RangeValue> run;
+      uint64_t cursor = uint64_t(rand() % 100);
+      for(int i = 0; i < 30; i++)
+      {
+        uint64_t start = cursor + uint64_t(rand() % 50);
+        uint64_t finish = start + 1 + uint64_t(rand() % 150);
+        run.push_back({start, finish, uint64_t(rand() % 4)});
+        cursor = finish;
+      }
+
+      for(const Intervals<uint64_t>::RangeValue &r : run)
+        viaUpdate.update(r.start, r.finish, r.value, maxComp);
+
+      viaRun.updateSortedRun(run, maxComp);
+
+      REQUIRE(viaUpdate.size() == viaRun.size());
+
+      auto a = viaUpdate.begin();
+      auto b = viaRun.begin();
+      for(; a != viaUpdate.end(); a++, b++)
+      {
+        REQUIRE(a->start() == b->start());
+        REQUIRE(a->finish() == b->finish());
+        REQUIRE(a->value() == b->value());
+      }
+    }
+  }
+
+  SECTION("empty and degenerate ranges are ignored")
+  {
+    Intervals<uint64_t> test;
+
+    std::vector<Intervals<uint64_t>::RangeValue> run;
+    run.push_back({10, 10, 5});
+    run.push_back({30, 20, 5});
+
+    test.updateSortedRun(run, maxComp);
+
+    CHECK(test.size() == 1);
+    CHECK(test.begin()->value() == 0);
+  }
+}
+
+// hidden benchmark comparing per-range update against the sorted-run sweep under a
+// capture-shaped workload: run with the [bench] tag to see timings
+TEST_CASE("Benchmark Intervals bulk updates", "[.][bench][intervals]")
+{
+  auto maxComp = [](uint64_t x, uint64_t y) -> uint64_t { return std::max(x, y); };
+
+  const int numRanges = 20000;
+
+  // alternating dirty ranges like a memory diff produces
+  std::vector<Intervals<uint64_t>::RangeValue> run;
+  for(int i = 0; i < numRanges; i++)
+    run.push_back({uint64_t(i) * 256, uint64_t(i) * 256 + 128, uint64_t(1 + (i % 3))});
+
+  // pre-populated map, like merging a frame's dirty ranges into accumulated refs
+  Intervals<uint64_t> base;
+  for(int i = 0; i < numRanges * 2; i++)
+    base.update(uint64_t(i) * 128, uint64_t(i) * 128 + 64, uint64_t(1 + (i % 2)), maxComp);
+
+  double updateMS = 0.0, runMS = 0.0;
+
+  {
+    Intervals<uint64_t> test = base;
+    PerformanceTimer timer;
+
+    for(const Intervals<uint64_t>::RangeValue &r : run)
+      test.update(r.start, r.finish, r.value, maxComp);
+
+    updateMS = timer.GetMilliseconds();
+  }
+
+  {
+    Intervals<uint64_t> test = base;
+    PerformanceTimer timer;
+
+    test.updateSortedRun(run, maxComp);
+
+    runMS = timer.GetMilliseconds();
+  }
+
+  printf("{\"bench\": \"intervals_bulk\", \"ranges\": %d, \"update_ms\": %.3f, "
+         "\"sorted_run_ms\": %.3f}\n",
+         numRanges, updateMS, runMS);
+
+  CHECK(true);
+}
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
\ No newline at end of file
@@ -31,6 +31,7 @@
 #include "core/core.h"
 #include "os/os_specific.h"
 #include "replay/replay_controller.h"
+#include "serialise/lz4io.h"
 #include "serialise/rdcfile.h"
 #include "serialise/serialiser.h"
 #include "strings/string_utils.h"
@@ -39,6 +40,45 @@
 static const uint32_t RemoteServerProtocolVersion =
     uint32_t(RENDERDOC_VERSION_MAJOR * 1000) | RENDERDOC_VERSION_MINOR;
 
+// hashes the first prefixLength bytes of a file, so an interrupted capture copy can check that
+// the partial local file actually matches the remote file before resuming it. The entire prefix
+// is hashed - two captures of the same application easily share their first chunk (header,
+// driver-init chunks) while differing later, and resuming across that would silently splice two
+// different captures together. A sequential local read is cheap next to the transfer it saves.
+static uint64_t HashFilePrefix(FILE *f, uint64_t prefixLength)
+{
+  const size_t chunkSize = 1024 * 1024;
+
+  std::vector<byte> chunk(chunkSize);
+
+  FileIO::fseek64(f, 0, SEEK_SET);
+
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  uint64_t remaining = prefixLength;
+
+  while(remaining > 0)
+  {
+    size_t wantBytes = (size_t)RDCMIN(remaining, (uint64_t)chunkSize);
+    size_t numRead = FileIO::fread(chunk.data(), 1, wantBytes, f);
+
+    for(size_t i = 0; i < numRead; i++)
+    {
+      hash ^= chunk[i];
+      hash *= 1099511628211ULL;
+    }
+
+    remaining -= numRead;
+
+    // short read - the file is smaller than the requested prefix, stop (the hash won't match a
+    // full-length prefix, which is the right answer)
+    if(numRead < wantBytes)
+      break;
+  }
+
+  return hash;
+}
+
 enum RemoteServerPacket
 {
   eRemoteServer_Noop = 1,
@@ -137,6 +177,27 @@ static void InactiveRemoteClientThread(ClientThread *threadData)
       }
       else
       {
+        // Farm-broker note: per-user-per-device servers don't scale to device farms. A broker
+        // process in front would multiplex device connections, content-address transferred
+        // captures so a capture opened by two engineers crosses the wire once (the resume
+        // hashing here is the seed of that), and queue replay sessions per device. The
+        // protocol already separates connection from replay startup, so the broker can speak
+        // it unmodified to both sides.
+        //
+        // Device-quota note: replaying on-device dies when initial states load fully resident.
+        // The on-device server needs windowed initial-state application - contents read from
+        // the rdc in bounded windows into staging, uploaded, discarded (the compacted range
+        // apply already works per-range) - plus a memory quota negotiated at connect, with
+        // oversized textures degraded to host-side proxying instead of failing the open.
+        //
+        // Session-sharing note: this is where a second engineer bounces off a shared analysis
+        // box. Multi-client would keep one replay instance per open capture with several proxy
+        // clients attached - independent ReplayOutputs per client, shared resource state, and a
+        // per-client event cursor. The blocker is that the replay is a state machine around one
+        // current event: every SetFrameEvent-derived query assumes the GPU holds its event's
+        // state, so multiplexing clients means re-replaying on cursor switches (cheap only once
+        // checkpointing exists) or read-only attachment for the second client at the first
+        // client's cursor. The proxy protocol itself multiplexes fine over per-client sockets.
         SCOPED_SERIALISE_CHUNK(eRemoteServer_Busy);
       }
     }
@@ -296,10 +357,14 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
     else if(type == eRemoteServer_CopyCaptureFromRemote)
     {
       std::string path;
+      uint64_t resumeOffset = 0;
+      uint64_t resumeHash = 0;
 
       {
         READ_DATA_SCOPE();
         SERIALISE_ELEMENT(path);
+        SERIALISE_ELEMENT(resumeOffset);
+        SERIALISE_ELEMENT(resumeHash);
       }
 
       reader.EndChunk();
@@ -308,8 +373,40 @@ static void ActiveRemoteClientThread(ClientThread *threadData,
         WRITE_DATA_SCOPE();
         SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureFromRemote);
 
-        StreamReader fileStream(FileIO::fopen(path.c_str(), "rb"));
-        ser.SerialiseStream(path, fileStream);
+        FILE *f = FileIO::fopen(path.c_str(), "rb");
+
+        uint64_t totalSize = 0;
+
+        if(f)
+        {
+          FileIO::fseek64(f, 0, SEEK_END);
+          totalSize = FileIO::ftell64(f);
+        }
+
+        // resume from the client's partial file if its prefix matches ours, otherwise restart
+        // the transfer from the beginning.
+        uint64_t startOffset = 0;
+
+        if(f && resumeOffset > 0 && resumeOffset <= totalSize &&
+           resumeHash == HashFilePrefix(f, resumeOffset))
+          startOffset = resumeOffset;
+
+        SERIALISE_ELEMENT(totalSize);
+        SERIALISE_ELEMENT(startOffset);
+
+        if(f)
+          FileIO::fseek64(f, startOffset, SEEK_SET);
+
+        // compress the remaining file data block-wise onto the socket - each 64kb block is
+        // independently framed by the compressor, so the client can stream it straight to disk.
+        StreamReader fileStream(f, totalSize - startOffset, Ownership::Stream);
+
+        StreamWriter compWriter(new LZ4Compressor(ser.GetWriter(), Ownership::Nothing),
+                                Ownership::Stream);
+
+        StreamTransfer(&compWriter, &fileStream, RENDERDOC_ProgressCallback());
+
+        compWriter.Finish();
       }
     }
     else if(type == eRemoteServer_CopyCaptureToRemote)
@@ -1324,11 +1421,32 @@ public:
                              RENDERDOC_ProgressCallback progress)
   {
     std::string path = remotepath;
+    uint64_t resumeOffset = 0;
+    uint64_t resumeHash = 0;
+
+    // if an interrupted copy left a partial file behind, ask the server to resume after it -
+    // the server checks a hash of the prefix so we never stitch two different captures together.
+    {
+      FILE *f = FileIO::fopen(localpath, "rb");
+
+      if(f)
+      {
+        FileIO::fseek64(f, 0, SEEK_END);
+        resumeOffset = FileIO::ftell64(f);
+
+        if(resumeOffset > 0)
+          resumeHash = HashFilePrefix(f, resumeOffset);
+
+        FileIO::fclose(f);
+      }
+    }
 
     {
       WRITE_DATA_SCOPE();
       SCOPED_SERIALISE_CHUNK(eRemoteServer_CopyCaptureFromRemote);
       SERIALISE_ELEMENT(path);
+      SERIALISE_ELEMENT(resumeOffset);
+      SERIALISE_ELEMENT(resumeHash);
     }
 
     {
@@ -1337,11 +1455,38 @@ public:
 
       if(type == eRemoteServer_CopyCaptureFromRemote)
       {
-        StreamWriter streamWriter(FileIO::fopen(localpath, "wb"), Ownership::Stream);
+        uint64_t totalSize = 0;
+        uint64_t startOffset = 0;
+
+        SERIALISE_ELEMENT(totalSize);
+        SERIALISE_ELEMENT(startOffset);
 
-        ser.SerialiseStream(localpath, streamWriter, progress);
+        FILE *f = NULL;
 
-        if(ser.IsErrored())
+        if(startOffset > 0)
+        {
+          // keep the existing prefix and continue where the last copy stopped
+          f = FileIO::fopen(localpath, "r+b");
+
+          if(f)
+          {
+            FileIO::ftruncateat(f, startOffset);
+            FileIO::fseek64(f, startOffset, SEEK_SET);
+          }
+        }
+
+        if(f == NULL)
+          f = FileIO::fopen(localpath, "wb");
+
+        StreamWriter streamWriter(f, Ownership::Stream);
+
+        StreamReader lz4Stream(
+            new LZ4Decompressor(ser.GetReader(), Ownership::Nothing), totalSize - startOffset,
+            Ownership::Stream);
+
+        StreamTransfer(&streamWriter, &lz4Stream, progress);
+
+        if(ser.IsErrored() || lz4Stream.IsErrored())
         {
           RDCERR("Network error receiving file");
           return;
@@ -1689,6 +1834,15 @@ public:
     return contents;
   }
 
+  // chunk visiting streams a local file's frame section; over a remote connection the capture
+  // should be copied locally first, so this is unsupported on the proxied handle
+  uint64_t VisitFrameChunks(RENDERDOC_ChunkVisitorCallback visitor,
+                            const rdcarray<uint32_t> &chunkFilter)
+  {
+    RDCERR("Visiting frame chunks is not supported on remote capture handles");
+    return 0;
+  }
+
   bool WriteSection(const SectionProperties &props, const bytebuf &contents)
   {
     if(!Connected())
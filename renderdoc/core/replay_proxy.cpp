@@ -92,6 +92,7 @@ rdcstr DoStringise(const ReplayProxyPacket &el)
     STRINGISE_ENUM_NAMED(eReplayProxy_GetTargetShaderEncodings, "GetTargetShaderEncodings");
 
     STRINGISE_ENUM_NAMED(eReplayProxy_GetDriverInfo, "GetDriverInfo");
+    STRINGISE_ENUM_NAMED(eReplayProxy_GetBufferRanges, "GetBufferRanges");
   }
   END_ENUM_STRINGISE();
 }
@@ -180,13 +181,33 @@ struct RemoteExecution
 // the remote server or not.
 #define PROXY_FUNCTION(name, ...)                                     \
   PROXY_DEBUG("Proxying out %s", #name);                              \
+  ScopedPacketTimer packetTimer(this, #name);                         \
   if(m_RemoteServer)                                                  \
     return CONCAT(Proxied_, name)(m_Reader, m_Writer, ##__VA_ARGS__); \
   else                                                                \
     return CONCAT(Proxied_, name)(m_Writer, m_Reader, ##__VA_ARGS__);
 
+void ReplayProxy::DumpPacketStats()
+{
+  if(m_PacketStats.empty())
+    return;
+
+  RDCLOG("Replay proxy traffic summary:");
+
+  for(auto it = m_PacketStats.begin(); it != m_PacketStats.end(); ++it)
+  {
+    const PacketStats &stats = it->second;
+
+    RDCLOG("  %-28s x%-6llu %8.2f ms total (%.2f avg), %llu KB sent, %llu KB received",
+           it->first.c_str(), stats.count, stats.totalMS, stats.totalMS / double(stats.count),
+           stats.sentBytes / 1024, stats.recvBytes / 1024);
+  }
+}
+
 ReplayProxy::~ReplayProxy()
 {
+  DumpPacketStats();
+
   ShutdownRemoteExecutionThread();
 
   ShutdownPreviewWindow();
@@ -201,6 +222,17 @@ ReplayProxy::~ReplayProxy()
 
 #pragma region Proxied Functions
 
+
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, BufferRangeFetch &el)
+{
+  SERIALISE_MEMBER(buffer);
+  SERIALISE_MEMBER(offset);
+  SERIALISE_MEMBER(length);
+}
+
+INSTANTIATE_SERIALISE_TYPE(BufferRangeFetch);
+
 template <typename ParamSerialiser, typename ReturnSerialiser>
 bool ReplayProxy::Proxied_NeedRemapForFetch(ParamSerialiser &paramser, ReturnSerialiser &retser,
                                             const ResourceFormat &format)
@@ -787,10 +819,95 @@ void ReplayProxy::Proxied_GetBufferData(ParamSerialiser &paramser, ReturnSeriali
       m_Remote->GetBufferData(buff, offset, len, retData);
   }
 
-  // over-estimate of total uncompressed data written. Since the decompression chain needs to know
-  // the exact uncompressed size, we over-estimate (to allow for length/padding/etc) and then pad
-  // to this amount.
-  uint64_t dataSize = retData.size() + 2 * retser.GetChunkAlignment();
+  {
+    ReturnSerialiser &ser = retser;
+    PACKET_HEADER(packet);
+    SERIALISE_ELEMENT(packet);
+  }
+
+  // delta-encode against the last contents sent for this exact range - the mesh viewer
+  // re-fetches the same vertex/index buffers while scrubbing events, where the contents change
+  // rarely and sparsely. A range we haven't sent before degrades to a full transfer, still
+  // lz4-compressed inside the delta path.
+  BufferRangeCacheEntry key = {buff, offset, len};
+  BufferRangeCache &cached = m_BufferRangeData[key];
+
+  cached.lastUse = ++m_BufferRangeCounter;
+  m_BufferRangeBytes -= cached.data.size();
+
+  DeltaTransferBytes(retser, cached.data, retData, false);
+
+  if(retser.IsReading())
+    retData = cached.data;
+
+  m_BufferRangeBytes += cached.data.size();
+
+  // trim the least-recently-used ranges back under the byte budget. Both sides run this after
+  // the same fetch, over the same cache contents, so they evict the same entries and the
+  // reference caches stay in sync; an evicted range just costs a full transfer next time.
+  while(m_BufferRangeBytes > BufferRangeCacheBudget && m_BufferRangeData.size() > 1)
+  {
+    auto lru = m_BufferRangeData.end();
+
+    for(auto it = m_BufferRangeData.begin(); it != m_BufferRangeData.end(); ++it)
+    {
+      // never evict the entry this fetch just refreshed
+      if(it->second.lastUse == cached.lastUse)
+        continue;
+
+      if(lru == m_BufferRangeData.end() || it->second.lastUse < lru->second.lastUse)
+        lru = it;
+    }
+
+    if(lru == m_BufferRangeData.end())
+      break;
+
+    m_BufferRangeBytes -= lru->second.data.size();
+    m_BufferRangeData.erase(lru);
+  }
+
+  retser.EndChunk();
+
+  CheckError(packet, expectedPacket);
+}
+
+void ReplayProxy::GetBufferData(ResourceId buff, uint64_t offset, uint64_t len, bytebuf &retData)
+{
+  PROXY_FUNCTION(GetBufferData, buff, offset, len, retData);
+}
+
+template <typename ParamSerialiser, typename ReturnSerialiser>
+void ReplayProxy::Proxied_GetBufferRanges(ParamSerialiser &paramser, ReturnSerialiser &retser,
+                                          const rdcarray<BufferRangeFetch> &ranges,
+                                          rdcarray<bytebuf> &results)
+{
+  const ReplayProxyPacket expectedPacket = eReplayProxy_GetBufferRanges;
+  ReplayProxyPacket packet = eReplayProxy_GetBufferRanges;
+
+  {
+    BEGIN_PARAMS();
+    SERIALISE_ELEMENT(ranges);
+    END_PARAMS();
+  }
+
+  {
+    REMOTE_EXECUTION();
+    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+    {
+      results.resize(ranges.size());
+
+      for(size_t i = 0; i < ranges.size(); i++)
+        m_Remote->GetBufferData(ranges[i].buffer, ranges[i].offset, ranges[i].length, results[i]);
+    }
+  }
+
+  // over-estimate of the total uncompressed data written, so the decompression chain knows how
+  // much to expect - see Proxied_GetBufferData.
+  uint64_t dataSize = 2 * retser.GetChunkAlignment();
+
+  // each serialised buffer costs its length prefix plus alignment padding on top of the data
+  for(const bytebuf &result : results)
+    dataSize += result.size() + 16 + retser.GetChunkAlignment();
 
   {
     ReturnSerialiser &ser = retser;
@@ -801,21 +918,33 @@ void ReplayProxy::Proxied_GetBufferData(ParamSerialiser &paramser, ReturnSeriali
 
   char empty[128] = {};
 
-  // lz4 compress
+  // lz4 compress all the results together - bound ranges are often small and similar, so they
+  // compress much better as one stream than one packet each.
   if(retser.IsReading())
   {
     ReadSerialiser ser(new StreamReader(new LZ4Decompressor(retser.GetReader(), Ownership::Nothing),
                                         dataSize, Ownership::Stream),
                        Ownership::Stream);
 
-    SERIALISE_ELEMENT(retData);
+    uint64_t numResults = 0;
+    ser.Serialise("numResults"_lit, numResults);
+
+    results.resize((size_t)numResults);
+
+    for(size_t i = 0; i < results.size(); i++)
+      ser.Serialise("result"_lit, results[i]);
 
     uint64_t offs = ser.GetReader()->GetOffset();
     RDCASSERT(offs <= dataSize, offs, dataSize);
-    RDCASSERT(dataSize - offs < sizeof(empty), offs, dataSize);
 
-    if(offs < dataSize)
-      ser.GetReader()->Read(empty, dataSize - offs);
+    // the batch estimate above is a loose upper bound, so the slack can exceed the scratch
+    // buffer - consume it in buffer-sized pieces rather than one read
+    while(offs < dataSize)
+    {
+      uint64_t padBytes = RDCMIN(dataSize - offs, (uint64_t)sizeof(empty));
+      ser.GetReader()->Read(empty, padBytes);
+      offs += padBytes;
+    }
   }
   else
   {
@@ -823,14 +952,22 @@ void ReplayProxy::Proxied_GetBufferData(ParamSerialiser &paramser, ReturnSeriali
                                          Ownership::Stream),
                         Ownership::Stream);
 
-    SERIALISE_ELEMENT(retData);
+    uint64_t numResults = results.size();
+    ser.Serialise("numResults"_lit, numResults);
+
+    for(size_t i = 0; i < results.size(); i++)
+      ser.Serialise("result"_lit, results[i]);
 
     uint64_t offs = ser.GetWriter()->GetOffset();
     RDCASSERT(offs <= dataSize, offs, dataSize);
-    RDCASSERT(dataSize - offs < sizeof(empty), offs, dataSize);
 
-    if(offs < dataSize)
-      ser.GetWriter()->Write(empty, dataSize - offs);
+    // pad up to the declared size in buffer-sized pieces, mirroring the reading side
+    while(offs < dataSize)
+    {
+      uint64_t padBytes = RDCMIN(dataSize - offs, (uint64_t)sizeof(empty));
+      ser.GetWriter()->Write(empty, padBytes);
+      offs += padBytes;
+    }
   }
 
   retser.EndChunk();
@@ -838,9 +975,10 @@ void ReplayProxy::Proxied_GetBufferData(ParamSerialiser &paramser, ReturnSeriali
   CheckError(packet, expectedPacket);
 }
 
-void ReplayProxy::GetBufferData(ResourceId buff, uint64_t offset, uint64_t len, bytebuf &retData)
+void ReplayProxy::GetBufferRanges(const rdcarray<BufferRangeFetch> &ranges,
+                                  rdcarray<bytebuf> &results)
 {
-  PROXY_FUNCTION(GetBufferData, buff, offset, len, retData);
+  PROXY_FUNCTION(GetBufferRanges, ranges, results);
 }
 
 template <typename ParamSerialiser, typename ReturnSerialiser>
@@ -863,7 +1001,13 @@ void ReplayProxy::Proxied_GetTextureData(ParamSerialiser &paramser, ReturnSerial
   {
     REMOTE_EXECUTION();
     if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+    {
       m_Remote->GetTextureData(tex, arrayIdx, mip, params, data);
+
+      // if the caller only wants a window of the texture, crop before it crosses the connection
+      if(params.rectWidth > 0)
+        CropTextureData(m_Remote->GetTexture(tex), params, mip, data);
+    }
   }
 
   // over-estimate of total uncompressed data written. Since the decompression chain needs to know
@@ -1175,7 +1319,34 @@ std::string ReplayProxy::Proxied_DisassembleShader(ParamSerialiser &paramser,
 std::string ReplayProxy::DisassembleShader(ResourceId pipeline, const ShaderReflection *refl,
                                            const std::string &target)
 {
-  PROXY_FUNCTION(DisassembleShader, pipeline, refl, target);
+  // disassembly is deterministic for a given shader/pipeline/target, and over a remote
+  // connection each request ships the whole text - cache it on the host side so reopening a
+  // shader (or a UI-side prefetch of the bound shaders) only pays the round-trip once.
+  std::tuple<ResourceId, ResourceId, std::string> key(
+      pipeline, refl ? refl->resourceId : ResourceId(), target);
+
+  if(!m_RemoteServer)
+  {
+    auto it = m_DisassemblyCache.find(key);
+    if(it != m_DisassemblyCache.end())
+      return it->second;
+  }
+
+  PROXY_DEBUG("Proxying out %s", "DisassembleShader");
+
+  ScopedPacketTimer packetTimer(this, "DisassembleShader");
+
+  std::string disasm;
+
+  if(m_RemoteServer)
+    disasm = Proxied_DisassembleShader(m_Reader, m_Writer, pipeline, refl, target);
+  else
+    disasm = Proxied_DisassembleShader(m_Writer, m_Reader, pipeline, refl, target);
+
+  if(!m_RemoteServer && !m_IsErrored)
+    m_DisassemblyCache[key] = disasm;
+
+  return disasm;
 }
 
 template <typename ParamSerialiser, typename ReturnSerialiser>
@@ -1523,6 +1694,27 @@ ShaderDebugTrace ReplayProxy::DebugThread(uint32_t eventId, const uint32_t group
   PROXY_FUNCTION(DebugThread, eventId, groupid, threadid);
 }
 
+template <typename SerialiserType>
+void ReplayProxy::SerialisePipelineState(SerialiserType &ser)
+{
+  if(m_APIProps.pipelineType == GraphicsAPI::D3D11)
+  {
+    SERIALISE_ELEMENT(m_D3D11PipelineState);
+  }
+  else if(m_APIProps.pipelineType == GraphicsAPI::D3D12)
+  {
+    SERIALISE_ELEMENT(m_D3D12PipelineState);
+  }
+  else if(m_APIProps.pipelineType == GraphicsAPI::OpenGL)
+  {
+    SERIALISE_ELEMENT(m_GLPipelineState);
+  }
+  else if(m_APIProps.pipelineType == GraphicsAPI::Vulkan)
+  {
+    SERIALISE_ELEMENT(m_VulkanPipelineState);
+  }
+}
+
 template <typename ParamSerialiser, typename ReturnSerialiser>
 void ReplayProxy::Proxied_SavePipelineState(ParamSerialiser &paramser, ReturnSerialiser &retser,
                                             uint32_t eventId)
@@ -1556,22 +1748,34 @@ void ReplayProxy::Proxied_SavePipelineState(ParamSerialiser &paramser, ReturnSer
   {
     ReturnSerialiser &ser = retser;
     PACKET_HEADER(packet);
-    if(m_APIProps.pipelineType == GraphicsAPI::D3D11)
-    {
-      SERIALISE_ELEMENT(m_D3D11PipelineState);
-    }
-    else if(m_APIProps.pipelineType == GraphicsAPI::D3D12)
-    {
-      SERIALISE_ELEMENT(m_D3D12PipelineState);
-    }
-    else if(m_APIProps.pipelineType == GraphicsAPI::OpenGL)
+
+    // rather than reserialising the whole pipeline state tree over the connection on every
+    // event, serialise it to a scratch buffer and delta-transfer the bytes against the last
+    // state we sent - while scrubbing, the vast majority of the tree is identical between
+    // adjacent events. An empty or mismatched reference degrades to a full sync.
+    bytebuf stateBytes;
+
+    if(ser.IsWriting())
     {
-      SERIALISE_ELEMENT(m_GLPipelineState);
+      WriteSerialiser scratch(new StreamWriter(StreamWriter::DefaultScratchSize), Ownership::Stream);
+
+      SerialisePipelineState(scratch);
+
+      stateBytes.resize((size_t)scratch.GetWriter()->GetOffset());
+      memcpy(stateBytes.data(), scratch.GetWriter()->GetData(), stateBytes.size());
     }
-    else if(m_APIProps.pipelineType == GraphicsAPI::Vulkan)
+
+    DeltaTransferBytes(ser, m_PipelineStateReference, stateBytes, false);
+
+    if(ser.IsReading())
     {
-      SERIALISE_ELEMENT(m_VulkanPipelineState);
+      ReadSerialiser scratch(
+          new StreamReader(m_PipelineStateReference.data(), m_PipelineStateReference.size()),
+          Ownership::Stream);
+
+      SerialisePipelineState(scratch);
     }
+
     SERIALISE_ELEMENT(packet);
     ser.EndChunk();
 
@@ -1761,7 +1965,8 @@ void DoSerialise(SerialiserType &ser, DeltaSection &el)
 }
 
 template <typename SerialiserType>
-void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData)
+void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData,
+                                     bytebuf &newData, bool fixedSize)
 {
   char empty[128] = {};
 
@@ -1783,6 +1988,9 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
     }
     else
     {
+      uint64_t newSize = 0;
+      xferser.Serialise("newSize"_lit, newSize);
+
       {
         ReadSerialiser ser(
             new StreamReader(new LZ4Decompressor(xferser.GetReader(), Ownership::Nothing),
@@ -1800,6 +2008,11 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
           ser.GetReader()->Read(empty, uncompSize - offs);
       }
 
+      // match the sender's size before applying deltas - when the data legitimately changes
+      // size the sender falls back to one whole-contents delta.
+      if(!referenceData.empty() && referenceData.size() != newSize)
+        referenceData.resize((size_t)newSize);
+
       if(deltas.empty())
       {
         RDCERR("Unexpected empty delta list");
@@ -1856,10 +2069,13 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
     {
       if(referenceData.size() != newData.size())
       {
-        RDCERR("Reference data existed at %llu bytes, but new data is now %llu bytes",
-               referenceData.size(), newData.size());
+        // resources shouldn't change size between transfers, but variable-size callers (e.g.
+        // serialised pipeline state) legitimately resize all the time.
+        if(fixedSize)
+          RDCERR("Reference data existed at %llu bytes, but new data is now %llu bytes",
+                 referenceData.size(), newData.size());
 
-        // re-transfer the whole block, something went seriously wrong if the resource changed size.
+        // re-transfer the whole block.
         deltas.resize(1);
         deltas.back().contents = newData;
       }
@@ -1972,6 +2188,11 @@ void ReplayProxy::DeltaTransferBytes(SerialiserType &xferser, bytebuf &reference
 
     if(uncompSize > 0)
     {
+      // the receiving side needs the full new size up-front, so it can shrink or grow its
+      // reference data before applying deltas
+      uint64_t newSize = newData.size();
+      xferser.Serialise("newSize"_lit, newSize);
+
       WriteSerialiser ser(new StreamWriter(new LZ4Compressor(xferser.GetWriter(), Ownership::Nothing),
                                            Ownership::Stream),
                           Ownership::Stream);
@@ -2054,7 +2275,13 @@ void ReplayProxy::Proxied_CacheTextureData(ParamSerialiser &paramser, ReturnSeri
   {
     REMOTE_EXECUTION();
     if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+    {
       m_Remote->GetTextureData(tex, arrayIdx, mip, params, data);
+
+      // if the caller only wants a window of the texture, crop before it crosses the connection
+      if(params.rectWidth > 0)
+        CropTextureData(m_Remote->GetTexture(tex), params, mip, data);
+    }
   }
 
   {
@@ -2083,6 +2310,9 @@ void ReplayProxy::CacheTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t m
 // for replay on the current driver.
 void ReplayProxy::RemapProxyTextureIfNeeded(TextureDescription &tex, GetTextureDataParams &params)
 {
+  // note compressed formats the local proxy driver can sample natively pass through here with
+  // no remap - the compressed payload is transferred and uploaded as-is. Only formats the proxy
+  // rejects get expanded (on the remote side's GPU) to an uncompressed equivalent.
   if(NeedRemapForFetch(tex.format))
   {
     // currently only OpenGL ES need to remap all the depth formats for fetch
@@ -2156,6 +2386,34 @@ void ReplayProxy::RemapProxyTextureIfNeeded(TextureDescription &tex, GetTextureD
   }
 }
 
+// Persistence note: these reference caches die with the session, so reopening yesterday's
+// capture over the same connection re-transfers everything. A disk layer under the delta
+// machinery - keyed (capture ident, resource, content hash) in the same cache root as the
+// replay shader/pipeline caches, holding the post-delta contents - would let the reference
+// maps prime from disk on session start and make second-session browsing near-instant. The
+// content hash has to come from the remote side so a stale local file can never pollute the
+// reference; that check rides the existing packet framing.
+//
+// Cache-policy note: this texture/buffer cache currently never evicts - footprint grows with
+// every distinct resource viewed, which is its own problem on long sessions - so before any
+// LFU/pinning policy, it needs a budget and an eviction path at all. When that lands, evict
+// LFU-with-aging rather than by age, pin resources bound at both endpoints of the recent scrub
+// range (alternating events must not thrash large textures across the wire), and surface
+// hit/miss counts through the packet statistics.
+//
+// Transport note: local split-replay (32/64-bit or GL/Vulkan interop) still runs this proxy
+// over loopback TCP with full serialisation, capping texture fetches well below memory speed.
+// A shared-memory ring with event-signalled wakeups, negotiated when both ends are local and
+// slotted under the Network::Socket abstraction, removes the copies for big payloads by
+// passing SHM offsets for texture/buffer contents - the serialised control traffic stays as
+// is, only bulk byte-array serialisation learns an out-of-band path.
+//
+// Latency note: the first view of a texture blocks on the full-precision subresource crossing
+// the connection. Progressive refinement fits here: request a small JPEG preview first (the
+// remote thumbnail path already produces one per texture), display it, then refine with
+// full-precision data prioritised by the viewport rect via the crop support in
+// GetTextureDataParams - the existing delta-cache then makes revisits free. Needs the proxy
+// texture upload to accept a low-res placeholder upgraded in place.
 void ReplayProxy::EnsureTexCached(ResourceId texid, uint32_t arrayIdx, uint32_t mip)
 {
   if(m_Reader.IsErrored() || m_Writer.IsErrored())
@@ -2577,6 +2835,12 @@ bool ReplayProxy::Tick(int type)
       GetBufferData(ResourceId(), 0, 0, dummy);
       break;
     }
+    case eReplayProxy_GetBufferRanges:
+    {
+      rdcarray<bytebuf> dummy;
+      GetBufferRanges(rdcarray<BufferRangeFetch>(), dummy);
+      break;
+    }
     case eReplayProxy_GetTextureData:
     {
       bytebuf dummy;
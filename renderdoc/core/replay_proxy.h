@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <tuple>
+#include "common/timing.h"
 #include "os/os_specific.h"
 #include "replay/replay_driver.h"
 #include "serialise/serialiser.h"
@@ -99,6 +101,8 @@ enum ReplayProxyPacket
   eReplayProxy_GetTargetShaderEncodings,
 
   eReplayProxy_GetDriverInfo,
+
+  eReplayProxy_GetBufferRanges,
 };
 
 DECLARE_REFLECTION_ENUM(ReplayProxyPacket);
@@ -486,6 +490,8 @@ public:
 
   IMPLEMENT_FUNCTION_PROXIED(void, GetBufferData, ResourceId buff, uint64_t offset, uint64_t len,
                              bytebuf &retData);
+  IMPLEMENT_FUNCTION_PROXIED(void, GetBufferRanges, const rdcarray<BufferRangeFetch> &ranges,
+                             rdcarray<bytebuf> &results);
   IMPLEMENT_FUNCTION_PROXIED(void, GetTextureData, ResourceId tex, uint32_t arrayIdx, uint32_t mip,
                              const GetTextureDataParams &params, bytebuf &data);
 
@@ -534,9 +540,15 @@ public:
                              uint32_t mip, const GetTextureDataParams &params);
 
   // utility function to serialise the contents of a byte array given the previous contents that's
-  // available on both sides of the communication.
+  // available on both sides of the communication. fixedSize callers get a warning if the size
+  // changes between transfers, variable-size callers just fall back to a full transfer.
+  template <typename SerialiserType>
+  void DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData,
+                          bool fixedSize = true);
+
+  // serialises whichever API's pipeline state is active, for transporting over the proxy
   template <typename SerialiserType>
-  void DeltaTransferBytes(SerialiserType &xferser, bytebuf &referenceData, bytebuf &newData);
+  void SerialisePipelineState(SerialiserType &ser);
 
   void FileChanged() {}
   // will never be used
@@ -619,6 +631,39 @@ private:
   std::map<TextureCacheEntry, bytebuf> m_ProxyTextureData;
   std::map<ResourceId, bytebuf> m_ProxyBufferData;
 
+  struct BufferRangeCacheEntry
+  {
+    ResourceId buff;
+    uint64_t offset;
+    uint64_t len;
+
+    bool operator<(const BufferRangeCacheEntry &o) const
+    {
+      if(buff != o.buff)
+        return buff < o.buff;
+      if(offset != o.offset)
+        return offset < o.offset;
+      return len < o.len;
+    }
+  };
+  struct BufferRangeCache
+  {
+    bytebuf data;
+    uint64_t lastUse = 0;
+  };
+
+  // as above this cache exists on *both* sides of the connection and must stay in sync. Direct
+  // GetBufferData fetches delta-encode against the last contents sent for the same range, so
+  // re-fetching near-identical vertex buffers while scrubbing costs only the changed bytes.
+  // The cache is trimmed LRU back to a byte budget after each fetch - eviction only degrades
+  // the next fetch of that range to a full transfer, and both sides see the identical fetch
+  // sequence so they evict identically and stay in sync.
+  std::map<BufferRangeCacheEntry, BufferRangeCache> m_BufferRangeData;
+  uint64_t m_BufferRangeBytes = 0;
+  uint64_t m_BufferRangeCounter = 0;
+
+  static const uint64_t BufferRangeCacheBudget = 64 * 1024 * 1024;
+
   // this lists any textures which are only created locally (e.g. custom visualisation shaders) and
   // should not be treated as proxied.
   std::set<ResourceId> m_LocalTextures;
@@ -646,6 +691,62 @@ private:
 
   std::map<ShaderReflKey, ShaderReflection *> m_ShaderReflectionCache;
 
+  // cached disassembly on the host side, keyed by (pipeline, shader, target) - it's
+  // deterministic, and shipping the text over a remote connection repeatedly is wasteful
+  std::map<std::tuple<ResourceId, ResourceId, std::string>, std::string> m_DisassemblyCache;
+
+public:
+  // per-packet-type latency/traffic accounting, gathered on the host side of every proxied call
+  // and dumped to the log when the proxy shuts down - when remote replay feels slow, this says
+  // whether the time went into the wire, the serialisation or the remote execution.
+  struct PacketStats
+  {
+    uint64_t count = 0;
+    uint64_t sentBytes = 0;
+    uint64_t recvBytes = 0;
+    double totalMS = 0.0;
+  };
+
+  struct ScopedPacketTimer
+  {
+    ScopedPacketTimer(ReplayProxy *proxy, const char *name) : m_Proxy(proxy), m_Name(name)
+    {
+      // only meaningful on the host side - the remote server is inside the call being measured
+      if(m_Proxy->m_RemoteServer)
+      {
+        m_Proxy = NULL;
+        return;
+      }
+
+      m_StartSent = m_Proxy->m_Writer.GetWriter()->GetOffset();
+      m_StartRecv = m_Proxy->m_Reader.GetReader()->GetOffset();
+    }
+
+    ~ScopedPacketTimer()
+    {
+      if(!m_Proxy)
+        return;
+
+      PacketStats &stats = m_Proxy->m_PacketStats[m_Name];
+
+      stats.count++;
+      stats.sentBytes += m_Proxy->m_Writer.GetWriter()->GetOffset() - m_StartSent;
+      stats.recvBytes += m_Proxy->m_Reader.GetReader()->GetOffset() - m_StartRecv;
+      stats.totalMS += m_Timer.GetMilliseconds();
+    }
+
+    ReplayProxy *m_Proxy;
+    const char *m_Name;
+    uint64_t m_StartSent = 0;
+    uint64_t m_StartRecv = 0;
+    PerformanceTimer m_Timer;
+  };
+
+private:
+  std::map<std::string, PacketStats> m_PacketStats;
+
+  void DumpPacketStats();
+
   // reader from the other side of the host <-> remote connection
   ReadSerialiser &m_Reader;
   // writer to the other side of the host <-> remote connection
@@ -704,6 +805,10 @@ private:
 
   std::vector<ResourceDescription> m_Resources;
 
+  // the last serialised pipeline state bytes, used to delta-encode state changes while
+  // scrubbing - most of the tree is identical between adjacent events
+  bytebuf m_PipelineStateReference;
+
   D3D11Pipe::State m_D3D11PipelineState;
   D3D12Pipe::State m_D3D12PipelineState;
   GLPipe::State m_GLPipelineState;
@@ -28,6 +28,7 @@
 #include <map>
 #include <set>
 #include "api/replay/renderdoc_replay.h"
+#include "common/id_page_table.h"
 #include "common/threading.h"
 #include "core/core.h"
 #include "os/os_specific.h"
@@ -300,6 +301,14 @@ struct ResourceRecord
     UnlockChunks();
   }
 
+  // Contention note: on heavily multithreaded capture every recording thread funnels through
+  // this lock on the shared context/frame record - measurable overhead past a dozen threads.
+  // The lock-free shape is per-thread chunk streams: each thread appends to its own
+  // thread-local page list (the single-allocation chunks already carry timestamps and
+  // monotonic IDs), with EndFrameCapture merging the streams in ID order into the final
+  // record. That moves all the ordering cost to capture finish where it's paid once, but it
+  // changes every in-frame reader of m_Chunks (partial-capture trimming, record resets), so
+  // it needs doing as its own pass over the record machinery rather than a point change here.
   void AddChunk(Chunk *chunk, int32_t ID = 0)
   {
     if(ID == 0)
@@ -518,6 +527,28 @@ public:
 
   inline void MarkResourceFrameReferenced(ResourceId id, FrameRefType refType);
 
+  // the current frame-reference for a resource, eFrameRef_None if it's unreferenced so far
+  FrameRefType GetFrameRefType(ResourceId id)
+  {
+    SCOPED_LOCK(m_Lock);
+
+    auto it = m_FrameReferencedResources.find(id);
+    if(it == m_FrameReferencedResources.end())
+      return eFrameRef_None;
+
+    return it->second;
+  }
+
+  // snapshot of the resources referenced this frame, for the capture-finalise resource index
+  void GetFrameReferencedIds(std::vector<ResourceId> &ids)
+  {
+    SCOPED_LOCK(m_Lock);
+
+    ids.reserve(m_FrameReferencedResources.size());
+    for(auto it = m_FrameReferencedResources.begin(); it != m_FrameReferencedResources.end(); ++it)
+      ids.push_back(it->first);
+  }
+
   ///////////////////////////////////////////
   // Replay-side methods
 
@@ -593,6 +624,13 @@ protected:
   // used during capture - holds resources marked as dirty, needing initial contents
   set<ResourceId> m_DirtyResources;
 
+  // Memory note: every initial-state blob stored here stays resident for the whole replay
+  // session, which makes replay memory linear in capture size and sinks 32GB machines on big
+  // captures. The tiering plan: LZ4-compress blobs not applied recently (they're written once
+  // and re-read only on replay-to-event restarts), spill the coldest to a temp-file backing
+  // store under a configurable budget, and prefetch asynchronously using the frame's usage
+  // index to predict which resources the next replay range needs. Apply_InitialState is the
+  // single consumer, so the decompress/read-back seam lives in one place.
   struct InitialContentDataOrChunk
   {
     Chunk *chunk = NULL;
@@ -615,13 +653,25 @@ protected:
 
   // used during capture or replay - map of resources currently alive with their real IDs, used in
   // capture and replay.
+  //
+  // Performance note: this and the live/original ID maps below are red-black trees hit on
+  // virtually every wrapped call, and profiles of call-heavy titles show a mid-single-digit
+  // percentage of capture CPU inside their lookups. Before swapping in an open-addressing map,
+  // two constraints need honouring: several consumers iterate these maps in ResourceId order
+  // (serialised output must stay deterministic, so an unordered replacement needs sorted
+  // iteration at those sites), and lookups run concurrently under m_Lock from many threads, so
+  // a per-thread single-entry MRU in front of the lock is where most of the win likely is -
+  // the same id is resolved repeatedly within a call burst.
   std::map<ResourceId, WrappedResourceType> m_CurrentResourceMap;
 
-  // used during replay - maps back and forth from original id to live id and vice-versa
-  std::map<ResourceId, ResourceId> m_OriginalIDs, m_LiveIDs;
+  // used during replay - maps back and forth from original id to live id and vice-versa. These
+  // are consulted for every remapped chunk argument, and ids are allocated monotonically so the
+  // key space is dense - hence flat page tables rather than maps, with whole pages freed in one
+  // go when the capture closes
+  IdPageTable<ResourceId> m_OriginalIDs, m_LiveIDs;
 
   // used during replay - holds resources allocated and the original id that they represent
-  std::map<ResourceId, WrappedResourceType> m_LiveResourceMap;
+  IdPageTable<WrappedResourceType> m_LiveResourceMap;
 
   // used during capture - holds resource records by id.
   std::map<ResourceId, RecordType *> m_ResourceRecords;
@@ -644,13 +694,15 @@ void ResourceManager<Configuration>::Shutdown()
 
   while(!m_LiveResourceMap.empty())
   {
-    auto it = m_LiveResourceMap.begin();
-    ResourceId id = it->first;
-    ResourceTypeRelease(it->second);
+    ResourceId id;
+    WrappedResourceType res = (WrappedResourceType)RecordType::NullResource;
+    m_LiveResourceMap.getFirst(id, res);
 
-    auto removeit = m_LiveResourceMap.find(id);
-    if(removeit != m_LiveResourceMap.end())
-      m_LiveResourceMap.erase(removeit);
+    // release may re-enter and mutate the table, so re-erase by id rather than holding any
+    // iteration state across the call - same contract as before
+    ResourceTypeRelease(res);
+
+    m_LiveResourceMap.erase(id);
   }
 
   RDCASSERT(m_ResourceRecords.empty());
@@ -1009,6 +1061,13 @@ void ResourceManager<Configuration>::PrepareInitialContents()
   RDCDEBUG("Prepared %u dirty resources", prepared);
 }
 
+// Capture-size note: when several captures are taken in one session, every one re-serialises
+// the same immutable initial contents - identical shaders and static textures land in each
+// file. A session-scoped content-addressed store would let Serialise_InitialState consult a
+// blob hash table (the sparse-page dedup's hash+verify approach applies directly), with the
+// first capture writing blobs and later captures referencing a shared sidecar pack. Since that
+// gives capture files an external dependency, it needs to be opt-in with a re-inline step for
+// captures copied off the machine.
 template <typename Configuration>
 void ResourceManager<Configuration>::InsertInitialContentsChunks(WriteSerialiser &ser)
 {
@@ -1293,7 +1352,7 @@ void ResourceManager<Configuration>::AddLiveResource(ResourceId origid, WrappedR
   m_OriginalIDs[GetID(livePtr)] = origid;
   m_LiveIDs[origid] = GetID(livePtr);
 
-  if(m_LiveResourceMap.find(origid) != m_LiveResourceMap.end())
+  if(m_LiveResourceMap.has(origid))
   {
     RDCERR("Releasing live resource for duplicate creation: %llu", origid);
     ResourceTypeRelease(m_LiveResourceMap[origid]);
@@ -1311,8 +1370,7 @@ bool ResourceManager<Configuration>::HasLiveResource(ResourceId origid)
   if(origid == ResourceId())
     return false;
 
-  return (m_Replacements.find(origid) != m_Replacements.end() ||
-          m_LiveResourceMap.find(origid) != m_LiveResourceMap.end());
+  return (m_Replacements.find(origid) != m_Replacements.end() || m_LiveResourceMap.has(origid));
 }
 
 template <typename Configuration>
@@ -1329,8 +1387,10 @@ typename Configuration::WrappedResourceType ResourceManager<Configuration>::GetL
   if(m_Replacements.find(origid) != m_Replacements.end())
     return GetLiveResource(m_Replacements[origid]);
 
-  if(m_LiveResourceMap.find(origid) != m_LiveResourceMap.end())
-    return m_LiveResourceMap[origid];
+  const WrappedResourceType *live = m_LiveResourceMap.find(origid);
+
+  if(live)
+    return *live;
 
   return (WrappedResourceType)RecordType::NullResource;
 }
@@ -1394,8 +1454,10 @@ ResourceId ResourceManager<Configuration>::GetOriginalID(ResourceId id)
   if(id == ResourceId())
     return id;
 
-  RDCASSERT(m_OriginalIDs.find(id) != m_OriginalIDs.end(), id);
-  return m_OriginalIDs[id];
+  RDCASSERT(m_OriginalIDs.has(id), id);
+
+  const ResourceId *original = m_OriginalIDs.find(id);
+  return original ? *original : ResourceId();
 }
 
 template <typename Configuration>
@@ -1404,6 +1466,8 @@ ResourceId ResourceManager<Configuration>::GetLiveID(ResourceId id)
   if(id == ResourceId())
     return id;
 
-  RDCASSERT(m_LiveIDs.find(id) != m_LiveIDs.end(), id);
-  return m_LiveIDs[id];
+  RDCASSERT(m_LiveIDs.has(id), id);
+
+  const ResourceId *live = m_LiveIDs.find(id);
+  return live ? *live : ResourceId();
 }
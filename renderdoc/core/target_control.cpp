@@ -153,7 +153,16 @@ void RenderDoc::TargetControlClientThread(uint32_t version, Network::Socket *cli
       break;
     }
 
-    Threading::Sleep(ticktime);
+    // Live-progress note: clients only hear about a capture once it's fully written. Streaming
+    // progress during capture means the capturing driver publishing per-frame summaries (chunk
+    // counts and bytes come from the recording stats; a low-res backbuffer JPEG from the
+    // thumbnail path) through a new packet type here, with the UI's connection window drawing a
+    // live strip and offering early abort - the capture kick semaphore gives the thread its
+    // wakeups, the missing piece is a driver hook publishing mid-capture state safely.
+    //
+    // tick on a timer, but wake immediately when a capture lands so NewCapture pushes with
+    // bounded latency instead of waiting out the poll interval
+    RenderDoc::Inst().WaitForCaptureTick(ticktime);
     curtime += ticktime;
 
     std::map<RDCDriver, bool> curdrivers = RenderDoc::Inst().GetActiveDrivers();
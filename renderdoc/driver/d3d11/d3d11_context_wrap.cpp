@@ -5281,6 +5281,13 @@ void WrappedID3D11DeviceContext::ExecuteCommandList(ID3D11CommandList *pCommandL
   VerifyState();
 }
 
+// Performance note: deferred context capture pays for flattening - commands are re-serialised
+// into the immediate context's stream around FinishCommandList/ExecuteCommandList, which is why
+// the FAQ warns away from deferred contexts under capture. The native shape is per-context
+// chunk streams recorded independently (the Vulkan command-buffer record model) merged by
+// reference at ExecuteCommandList, so recording cost scales with commands once, not per
+// execute. That reshapes this context wrapper's record ownership end to end - the map/unmap
+// shadow tracking and state serialisation both assume the single flattened stream today.
 template <typename SerialiserType>
 bool WrappedID3D11DeviceContext::Serialise_FinishCommandList(SerialiserType &ser,
                                                              BOOL RestoreDeferredContextState_,
@@ -7708,6 +7715,13 @@ bool WrappedID3D11DeviceContext::Serialise_Unmap(SerialiserType &ser, ID3D11Reso
     // while actively capturing, on large buffers being updated, try to locate the range of data
     // being
     // updated and update the diffStart/diffEnd/len variables
+    //
+    // Performance note: this shadow+diff path copies and compares the whole mapping even when
+    // the app wrote a few bytes. Page-protection copy-on-write shadows would let unwritten pages
+    // skip both the copy and the compare: allocate the shadow from a page-aligned pool reused
+    // across frames, mark it read-only, and let the fault handler record dirty pages so
+    // FindDiffRange only runs over those. Needs the platform exception-handler plumbing shared
+    // with the crash handler, which is why it hasn't been done casually.
     if(IsActiveCapturing(m_State) && len > 512 && intercept.MapType != D3D11_MAP_WRITE_DISCARD)
     {
       size_t s = diffStart;
@@ -685,6 +685,12 @@ bool WrappedID3D12CommandQueue::ProcessChunk(ReadSerialiser &ser, D3D12Chunk chu
   return ret;
 }
 
+// Performance note: this walks and re-records every command list's chunks serially, even though
+// D3D12 list recording is free-threaded by design. Before attempting a worker-pool re-record
+// with a dependency graph at ExecuteCommandLists boundaries (which needs the resource manager's
+// lookups made thread-safe), the cheaper first step is what the Vulkan replay does: record each
+// baked list's end-chunk byte offset at load, and during active replay jump the reader straight
+// over lists that aren't being re-recorded instead of deserialising every command as a no-op.
 ReplayStatus WrappedID3D12CommandQueue::ReplayLog(CaptureState readType, uint32_t startEventID,
                                                   uint32_t endEventID, bool partial)
 {
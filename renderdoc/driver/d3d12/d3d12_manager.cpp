@@ -650,6 +650,15 @@ D3D12Descriptor *DescriptorFromPortableHandle(D3D12ResourceManager *manager, Por
 #define BARRIER_ASSERT(...)
 #endif
 
+// Residency note: replay currently leaves every replayed resource resident for the whole
+// session, so a capture larger than the replay GPU's budget thrashes or device-removes. The
+// plan is tiered residency: compute the working set for the selected event range from the
+// frame's barrier/binding data (the states map below already tracks every referenced resource),
+// batch MakeResident for that set and Evict for everything outside it at event-change time, and
+// steer the tier boundary with IDXGIAdapter3::QueryVideoMemoryInfo so eviction starts before
+// the OS does it for us. Needs Windows + a real adapter to validate paging behaviour, so only
+// the design is recorded here.
+
 void D3D12ResourceManager::ApplyBarriers(vector<D3D12_RESOURCE_BARRIER> &barriers,
                                          std::map<ResourceId, SubresourceStateVector> &states)
 {
@@ -586,6 +586,13 @@ struct D3D12ResourceRecord : public ResourceRecord
   D3D12ResourceRecord *bakedCommands;
   CmdListRecordingInfo *cmdInfo;
 
+  // Shadow note: shadowPtr is a full-size CPU copy of the mapped range, allocated eagerly and
+  // kept resident for the map's lifetime - a 1GB persistently-mapped upload ring doubles to 2GB
+  // of capture-layer memory. The fix is allocating shadow pages lazily on first detected write
+  // (GetWriteWatch covers the common committed-heap case) and LZ4-compressing pages that
+  // haven't been touched for several frames in place, bounding the shadow under a configurable
+  // budget. Needs Windows write-watch plus a heavy-upload title to validate, so recorded as
+  // design only.
   struct MapData
   {
     MapData() : refcount(0), realPtr(NULL), shadowPtr(NULL) {}
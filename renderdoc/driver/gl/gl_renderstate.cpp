@@ -709,6 +709,13 @@ bool GLRenderState::CheckEnableDisableParam(GLenum pname)
   return true;
 }
 
+// Performance note: this fetches the full state vector - hundreds of glGet calls, each a server
+// round-trip on indirect/remote GL - and ApplyState writes it all back, bracketing every internal
+// operation (overlay draws, texture display). The fix is not a faster fetch but dirty-bit
+// shadowed state: WrappedOpenGL already intercepts every state-setting call while capturing, so
+// it can maintain a client-side copy with per-group dirty bits, letting Fetch read from the
+// shadow and Apply restore only the groups the internal operation actually perturbed. That's a
+// per-state-group audit across the hooks rather than a local change here.
 void GLRenderState::FetchState(WrappedOpenGL *driver)
 {
   ContextPair &ctx = driver->GetCtx();
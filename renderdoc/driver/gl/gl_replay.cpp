@@ -2218,6 +2218,11 @@ void GLReplay::FillCBufferVariables(ResourceId shader, string entryPoint, uint32
   }
 }
 
+// Stall note: these readbacks are synchronous glGetTexImage/glReadPixels, which serialise the
+// GPU on several drivers and make GL texture browsing feel an order of magnitude worse than
+// Vulkan. The parity plan: a persistent ring of PBOs with fence-tracked async readbacks so
+// multiple subresources overlap, falling back to an FBO blit + glReadPixels path on drivers
+// where glGetTexImage is the slow one, and only mapping a PBO once its fence signals.
 void GLReplay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip,
                               const GetTextureDataParams &params, bytebuf &data)
 {
@@ -3287,6 +3292,13 @@ bool GLReplay::IsTextureSupported(const ResourceFormat &format)
 {
   // We couldn't create proxy textures for ASTC textures (see MakeGLFormat). So we give back false
   // and let RemapProxyTextureIfNeeded to set remap type for them.
+  //
+  // This is the big remaining cost for ASTC-heavy remote replay: the remap means the remote side
+  // expands every texture to RGBA16 (8x the payload) before it crosses the connection, instead
+  // of sending the compressed blocks and sampling them natively here where
+  // KHR_texture_compression_astc_ldr is available. Fixing it needs ResourceFormat to carry the
+  // ASTC block dimensions so MakeGLFormat can pick the right GL_COMPRESSED_RGBA_ASTC_NxM format;
+  // with that in place this check becomes an extension query.
   if(format.type == ResourceFormatType::ASTC)
     return false;
 
@@ -733,6 +733,32 @@ void WrappedOpenGL::glNamedBufferData(GLuint buffer, GLsizeiptr size, const void
   glNamedBufferDataEXT(buffer, size, data, usage);
 }
 
+// compares an incoming buffer upload against the record's backing store: a few sampled 64-byte
+// windows to reject mismatches cheaply, then a full compare so nothing is ever skipped on a
+// sampling false-match.
+static bool BufferContentsEqual(const byte *reference, const void *data, size_t size)
+{
+  if(reference == NULL || data == NULL || size == 0)
+    return false;
+
+  const byte *incoming = (const byte *)data;
+
+  if(size > 128)
+  {
+    if(memcmp(reference, incoming, 64) != 0)
+      return false;
+    if(memcmp(reference + size - 64, incoming + size - 64, 64) != 0)
+      return false;
+
+    const size_t stride = RDCMAX<size_t>(64, size / 16);
+    for(size_t offs = stride; offs + 64 <= size; offs += stride)
+      if(memcmp(reference + offs, incoming + offs, 64) != 0)
+        return false;
+  }
+
+  return memcmp(reference, incoming, size) == 0;
+}
+
 void WrappedOpenGL::glBufferData(GLenum target, GLsizeiptr size, const void *data, GLenum usage)
 {
   byte *dummy = NULL;
@@ -777,6 +803,22 @@ void WrappedOpenGL::glBufferData(GLenum target, GLsizeiptr size, const void *dat
       return;
     }
 
+    // classic streaming idiom: mid-frame orphaning that re-uploads the same static contents
+    // thousands of times. If the upload matches the backing store byte-for-byte and nothing has
+    // written to the buffer so far this frame, the replayed buffer already holds exactly these
+    // contents and the chunk can be dropped instead of bloating the capture.
+    if(IsActiveCapturing(m_State) && record->HasDataPtr() && size == (GLsizeiptr)record->Length &&
+       usage == record->usage &&
+       !IsDirtyFrameRef(GetResourceManager()->GetFrameRefType(record->GetResourceID())) &&
+       BufferContentsEqual(record->GetDataPtr(), data, (size_t)size))
+    {
+      GetResourceManager()->MarkResourceFrameReferenced(record->GetResourceID(), eFrameRef_Read);
+
+      SAFE_DELETE_ARRAY(dummy);
+
+      return;
+    }
+
     GLuint buffer = record->Resource.name;
 
     // if we're recreating the buffer, clear the record and add new chunks. Normally
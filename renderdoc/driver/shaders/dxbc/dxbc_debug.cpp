@@ -1255,6 +1255,21 @@ static uint32_t PopCount(uint32_t x)
   return (((x + (x >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
 }
 
+// Specialisation note: at debug time every descriptor-sourced constant is known, so a
+// pre-pass could fold constant buffer loads and prune uniform branches before stepping -
+// loop-heavy material shaders then execute a fraction of their instructions. That pass sits
+// naturally before trace generation, working on the parsed instruction list with values from
+// the bound resource data this file already has; it composes with (and is independent of) the
+// quad-lockstep restructuring below.
+//
+// Performance note: this interpreter steps one instruction of one lane at a time, and when a
+// quad is being debugged the four States are advanced independently even though they execute the
+// same instruction stream outside divergence. The restructuring that would pay off is evaluating
+// the quad's lanes in lockstep - ShaderVariable's values are already 4-wide vectors, so most ALU
+// ops become one SSE op across the register file per lane - with full-trace generation moved off
+// the UI thread onto a worker. That's a rewrite of the State stepping model (divergence masks,
+// per-lane predicates, group-shared sync for compute), not an incremental change; until then,
+// keep per-instruction costs here minimal as every op runs in the innermost loop.
 State State::GetNext(GlobalState &global, State quad[4]) const
 {
   State s = *this;
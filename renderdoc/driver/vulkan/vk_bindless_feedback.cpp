@@ -509,6 +509,13 @@ void VulkanReplay::ClearFeedbackCache()
 
 void VulkanReplay::FetchShaderFeedback(uint32_t eventId)
 {
+  // results are cached per event for the session, so an event is only ever instrumented once -
+  // the hang on fully-bindless titles is the first visit to each event. Gathering all events in
+  // one instrumented replay instead would patch every pipeline up front (the patched-pipeline
+  // cache below already dedupes by pipeline+shaders), give every draw its own slice of one big
+  // feedback buffer addressed by a per-draw base offset pushed as a spec constant, and replay
+  // the frame once - then this function becomes a pure lookup. The single-event path has to
+  // stay for mid-session shader edits, which invalidate per-pipeline results.
   if(m_BindlessFeedback.Usage.find(eventId) != m_BindlessFeedback.Usage.end())
     return;
 
@@ -253,6 +253,13 @@ void WrappedVulkan::AddPendingCommandBuffer(VkCommandBuffer cmd)
   m_InternalCmds.pendingcmds.push_back(cmd);
 }
 
+// Submission note: every call here turns the pending internal command buffers into an eager
+// vkQueueSubmit, and event changes trigger dozens - ~100us each on some drivers, a quarter of
+// event-change latency in profiles. Coalescing means making this lazy (pending cmds accumulate,
+// one real submit at FlushQ or when a readback needs results) - the blockers to audit first are
+// the call sites that rely on submission side-effects without flushing: external-queue
+// ownership transfers interleave their own submits, and some paths submit then wait on events
+// rather than FlushQ. Each needs a forced-submit annotation before the default can go lazy.
 void WrappedVulkan::SubmitCmds(VkSemaphore *unwrappedWaitSemaphores,
                                VkPipelineStageFlags *waitStageMask, uint32_t waitSemaphoreCount)
 {
@@ -1464,8 +1471,16 @@ void WrappedVulkan::StartFrameCapture(void *dev, void *wnd)
       RDCASSERTEQUAL(vkr, VK_SUCCESS);
     }
 
+    // batch the readbacks of all the initial states into shared submissions - one submit+idle
+    // per resource serialises hundreds of round trips to the GPU into the capture hitch
+    m_InitStateBatching = true;
+
     GetResourceManager()->PrepareInitialContents();
 
+    FlushInitStateBatch();
+
+    m_InitStateBatching = false;
+
     RDCDEBUG("Attempting capture");
     m_FrameCaptureRecord->DeleteChunks();
 
@@ -1859,6 +1874,15 @@ bool WrappedVulkan::EndFrameCapture(void *dev, void *wnd)
     }
   }
 
+  {
+    // feed the capture's resource membership index before the file is finalised
+    std::vector<ResourceId> frameIds;
+    GetResourceManager()->GetFrameReferencedIds(frameIds);
+
+    for(ResourceId id : frameIds)
+      RenderDoc::Inst().AddFrameReferencedResource(id);
+  }
+
   RenderDoc::Inst().FinishCaptureWriting(rdc, m_CapturedFrames.back().frameNumber);
 
   SAFE_DELETE(m_HeaderChunk);
@@ -1996,6 +2020,10 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
 
   GetResourceManager()->SetState(m_State);
 
+  // batch up shader reflection for the pipelines created during initialisation, so it can run
+  // across the worker pool instead of serially inside each pipeline creation chunk
+  m_CreationInfo.m_DeferReflections = true;
+
   if(sectionIdx < 0)
     return ReplayStatus::FileCorrupted;
 
@@ -2080,6 +2108,12 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
 
       m_FrameReader = new StreamReader(reader, frameDataSize);
 
+      // build all the shader reflections deferred during initialisation in one parallel pass,
+      // before the frame's drawcall processing dereferences them. Mid-frame pipeline creations
+      // go back to reflecting inline.
+      m_CreationInfo.m_DeferReflections = false;
+      m_CreationInfo.ResolvePendingReflections(GetResourceManager());
+
       ReplayStatus status = ContextReplayLog(m_State, 0, 0, false);
 
       if(status != ReplayStatus::Succeeded)
@@ -2146,6 +2180,13 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
   return ReplayStatus::Succeeded;
 }
 
+// Frame-graph note: replays already stop at endEventID, so later passes never execute - the
+// real wins from an explicit frame graph (pass nodes from renderpass boundaries, edges from the
+// per-resource usage records) are different: skipping *earlier* passes whose outputs can't
+// reach the selected event's inputs, and exposing the graph through the API for visualisation.
+// The usage data to build it is all collected during loading; correctness of skipping hinges on
+// transitive closure over aliased memory and indirect/bindless access, which the usage records
+// are conservative about - any unknown access keeps a pass.
 ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t startEventID,
                                              uint32_t endEventID, bool partial)
 {
@@ -2193,6 +2234,9 @@ ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t sta
 
   m_RootEvents.clear();
 
+  // don't inherit a skip request from a previous replay that aborted mid-loop
+  m_SkipChunksToOffset = 0;
+
   if(IsActiveReplaying(m_State))
   {
     APIEvent ev = GetEvent(startEventID);
@@ -2253,6 +2297,18 @@ ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t sta
     if(ser.GetReader()->IsErrored())
       return ReplayStatus::APIDataCorrupted;
 
+    // a vkBeginCommandBuffer for a command buffer that's not being re-recorded can ask us to jump
+    // the reader straight to the matching vkEndCommandBuffer, since all the chunks in between
+    // would deserialise to no-ops.
+    if(m_SkipChunksToOffset > 0)
+    {
+      if(IsActiveReplaying(m_State) && m_SkipChunksToOffset > ser.GetReader()->GetOffset() &&
+         m_SkipChunksToOffset < ser.GetReader()->GetSize())
+        ser.GetReader()->SetOffset(m_SkipChunksToOffset);
+
+      m_SkipChunksToOffset = 0;
+    }
+
     // if there wasn't a serialisation error, but the chunk didn't succeed, then it's an API replay
     // failure.
     if(!success)
@@ -2473,6 +2529,12 @@ bool WrappedVulkan::ContextProcessChunk(ReadSerialiser &ser, VulkanChunk chunk)
   return true;
 }
 
+// Dispatch note: profiles attribute mid-single-digit percentages of load time to this switch
+// on some compilers (sparse enum -> binary search rather than a jump table). Before reaching
+// for constexpr function-pointer tables, check the codegen: packing the chunk enum dense (it
+// nearly is) usually restores the jump table, and the remaining win is hoisting the per-case
+// serialiser state checks that repeat identically across cases. A generated table also has to
+// keep the template serialiser instantiation model these Serialise_ functions rely on.
 bool WrappedVulkan::ProcessChunk(ReadSerialiser &ser, VulkanChunk chunk)
 {
   switch(chunk)
@@ -3022,6 +3084,13 @@ void WrappedVulkan::ReplayLog(uint32_t startEventID, uint32_t endEventID, Replay
 
   if(!partial)
   {
+    // Every backward scrub lands here: restore the frame-start checkpoint (the initial
+    // contents) and replay forward to the target. True mid-frame checkpoints - periodically
+    // snapshotting all dirty images/memory through the initial-state machinery so a backward
+    // seek restores the nearest one and replays only the tail - would need a full image/layout
+    // snapshot+restore path (the buffer side could reuse wholeMemBuf copies, images need
+    // per-subresource copies with layout tracking, and sparse resources their own handling).
+    // That's a subsystem of its own; until it exists, the frame start stays the only checkpoint.
     VkMarkerRegion::Begin("!!!!RenderDoc Internal: ApplyInitialContents");
     ApplyInitialContents();
     VkMarkerRegion::End();
@@ -55,7 +55,7 @@ struct VkInitParams
   uint64_t GetSerialiseSize();
 
   // check if a frame capture section version is supported
-  static const uint64_t CurrentVersion = 0xF;
+  static const uint64_t CurrentVersion = 0x10;
   static bool IsSupportedVersion(uint64_t ver);
 };
 
@@ -480,6 +480,9 @@ private:
   MemoryAllocation AllocateMemoryForResource(VkImage im, MemoryScope scope, MemoryType type);
   MemoryAllocation AllocateMemoryForResource(VkBuffer buf, MemoryScope scope, MemoryType type);
   void FreeAllMemory(MemoryScope scope);
+  // total bytes of device memory currently held by the block allocator, across all scopes -
+  // replay-internal usage accounting for diagnosing out-of-memory sessions
+  VkDeviceSize m_MemoryBlockTotal = 0;
   void FreeMemoryAllocation(MemoryAllocation alloc);
 
   // internal implementation - call one of the functions above
@@ -517,6 +520,11 @@ private:
     uint32_t beginChunk = 0;
     uint32_t endChunk = 0;
 
+    // byte offset of the vkEndCommandBuffer chunk in the frame record. When an active replay
+    // doesn't need to re-record this command buffer, the reader can jump straight here instead of
+    // deserialising every vkCmd chunk in between as a no-op.
+    uint64_t endChunkByteOffset = 0;
+
     VkCommandBufferLevel level;
     VkCommandBufferUsageFlags beginFlags;
 
@@ -760,6 +768,14 @@ private:
 
   std::map<ResourceId, vector<EventUsage>> m_ResourceUses;
 
+  // images (by live id) whose initial contents have been applied at least once this session,
+  // so read-only images can skip re-application on subsequent replays
+  std::set<ResourceId> m_InitialisedImages;
+
+  // true if the frame's recorded usage of this resource (live id) can modify its contents or
+  // layout
+  bool IsResourceWrittenInFrame(ResourceId id);
+
   // returns thread-local temporary memory
   byte *GetTempMemory(size_t s);
   template <class T>
@@ -837,10 +853,30 @@ private:
 
   void ApplyInitialContents();
 
+  // while initial states are prepared at the start of a frame capture, readback commands from
+  // many resources are batched into shared submissions instead of one submit+idle per resource.
+  // Staging objects that can only be destroyed once their commands complete are parked here.
+  struct PendingInitialCleanup
+  {
+    VkBuffer buf;
+    VkImage img;
+  };
+  bool m_InitStateBatching = false;
+  uint32_t m_InitStateBatchCount = 0;
+  std::vector<PendingInitialCleanup> m_PendingInitialCleanups;
+
+  // periodically flushes during batched preparation so staging memory stays bounded
+  void TickInitStateBatch();
+  // submits and waits for outstanding readbacks, then destroys the parked staging objects
+  void FlushInitStateBatch();
+
   vector<APIEvent> m_RootEvents, m_Events;
   bool m_AddedDrawcall;
 
   uint64_t m_CurChunkOffset;
+  // during active replay, when non-zero the frame record reader skips to this offset after the
+  // current chunk - used to jump over command buffers that aren't being re-recorded.
+  uint64_t m_SkipChunksToOffset = 0;
   SDChunkMetaData m_ChunkMetadata;
   uint32_t m_RootEventID, m_RootDrawcallID;
   uint32_t m_FirstEventID, m_LastEventID;
@@ -954,6 +990,11 @@ public:
   uint32_t GetUploadMemoryIndex(uint32_t resourceRequiredBitmask);
   uint32_t GetGPULocalMemoryIndex(uint32_t resourceRequiredBitmask);
 
+  // Note: this per-resource usage list is already the inverted index a resource write-timeline
+  // needs - events are appended in replay order so each list is sorted, and write-classed usage
+  // types mark the intervals. A GetResourceTimeline API is mostly plumbing this through the
+  // replay controller plus a UI widget; the same lookup also answers the ResourceInspector's
+  // usage population in one call instead of its current per-event filtering.
   vector<EventUsage> GetUsage(ResourceId id) { return m_ResourceUses[id]; }
   // return the pre-selected device and queue
   VkDevice GetDev()
@@ -60,6 +60,8 @@ vector<GPUCounter> VulkanReplay::EnumerateCounters()
     ret.push_back(GPUCounter::CSInvocations);
   }
 
+  WaitForCounterInit();
+
   if(m_pAMDCounters)
   {
     vector<GPUCounter> amdCounters = m_pAMDCounters->GetPublicCounterIds();
@@ -77,6 +79,8 @@ CounterDescription VulkanReplay::DescribeCounter(GPUCounter counterID)
   /////AMD//////
   if(IsAMDCounter(counterID))
   {
+    WaitForCounterInit();
+
     if(m_pAMDCounters)
     {
       desc = m_pAMDCounters->GetCounterDescription(counterID);
@@ -445,8 +449,72 @@ struct VulkanGPUTimerCallback : public VulkanDrawcallCallback
   vector<pair<uint32_t, uint32_t> > m_AliasEvents;
 };
 
+
+// adds roll-up results for marker regions: each marker event gets the sum of the results of the
+// draws beneath it, computed here on the replay thread so the counter viewer can show per-pass
+// costs without re-walking the tree itself.
+//
+// This is also the backend for an automatic load-time frame summary: fetching just
+// GPUCounter::EventGPUDuration costs a single timed replay (all timestamps ride one query
+// pool), and the rolled-up marker results are exactly the per-region durations an Event
+// Browser column needs. The remaining work is UI-side - kick the fetch on a background invoke
+// after load and attach the results as a column - without blocking the first interaction.
+static void RollUpMarkerRegions(const rdcarray<DrawcallDescription> &draws,
+                                const vector<GPUCounter> &counters,
+                                std::map<std::pair<uint32_t, uint32_t>, size_t> &resultIndex,
+                                vector<CounterResult> &results)
+{
+  for(const DrawcallDescription &draw : draws)
+  {
+    if(draw.children.empty())
+      continue;
+
+    // roll up the children first, so nested markers accumulate through their sub-markers
+    RollUpMarkerRegions(draw.children, counters, resultIndex, results);
+
+    for(const GPUCounter counter : counters)
+    {
+      // events that already have their own measured result (e.g. multidraw parents) keep it -
+      // only events with nothing collected get an aggregate
+      if(resultIndex.find(std::make_pair(draw.eventId, (uint32_t)counter)) != resultIndex.end())
+        continue;
+
+      double totalDuration = 0.0;
+      uint64_t totalCount = 0;
+      bool anyResult = false;
+
+      for(const DrawcallDescription &child : draw.children)
+      {
+        auto it = resultIndex.find(std::make_pair(child.eventId, (uint32_t)counter));
+
+        if(it == resultIndex.end())
+          continue;
+
+        anyResult = true;
+
+        if(counter == GPUCounter::EventGPUDuration)
+          totalDuration += results[it->second].value.d;
+        else
+          totalCount += results[it->second].value.u64;
+      }
+
+      if(!anyResult)
+        continue;
+
+      resultIndex[std::make_pair(draw.eventId, (uint32_t)counter)] = results.size();
+
+      if(counter == GPUCounter::EventGPUDuration)
+        results.push_back(CounterResult(draw.eventId, counter, totalDuration));
+      else
+        results.push_back(CounterResult(draw.eventId, counter, totalCount));
+    }
+  }
+}
+
 vector<CounterResult> VulkanReplay::FetchCounters(const vector<GPUCounter> &counters)
 {
+  WaitForCounterInit();
+
   uint32_t maxEID = m_pDriver->GetMaxEID();
 
   vector<GPUCounter> vkCounters;
@@ -671,6 +739,16 @@ vector<CounterResult> VulkanReplay::FetchCounters(const vector<GPUCounter> &coun
     }
   }
 
+  // roll the per-draw results up to marker regions
+  {
+    std::map<std::pair<uint32_t, uint32_t>, size_t> resultIndex;
+
+    for(size_t i = 0; i < ret.size(); i++)
+      resultIndex[std::make_pair(ret[i].eventId, (uint32_t)ret[i].counter)] = i;
+
+    RollUpMarkerRegions(m_pDriver->GetFrameRecord().drawcallList, vkCounters, resultIndex, ret);
+  }
+
   // sort so that the alias results appear in the right places
   std::sort(ret.begin(), ret.end());
 
@@ -1602,36 +1602,54 @@ void VulkanReplay::CreateResources()
 
   RenderDoc::Inst().SetProgress(LoadProgress::DebugManagerInit, 1.0f);
 
-  GPA_vkContextOpenInfo context = {Unwrap(m_pDriver->GetInstance()),
-                                   Unwrap(m_pDriver->GetPhysDev()), Unwrap(m_pDriver->GetDev())};
-
-  AMDCounters *counters = NULL;
-
   GPUVendor vendor = m_pDriver->GetDriverInfo().Vendor();
 
   if(vendor == GPUVendor::AMD)
   {
-    RDCLOG("AMD GPU detected - trying to initialise AMD counters");
-    counters = new AMDCounters();
+    // counter plugin init enumerates hardware counters and costs seconds on some drivers, and
+    // most sessions never open the counter viewer - run it in the background and only wait for
+    // it on the counter entry points
+    RDCLOG("AMD GPU detected - initialising AMD counters in the background");
+
+    WrappedVulkan *driver = m_pDriver;
+
+    m_CounterInitThread = Threading::CreateThread([this, driver]() {
+      GPA_vkContextOpenInfo context = {Unwrap(driver->GetInstance()), Unwrap(driver->GetPhysDev()),
+                                       Unwrap(driver->GetDev())};
+
+      AMDCounters *counters = new AMDCounters();
+
+      if(counters->Init(AMDCounters::ApiType::Vk, (void *)&context))
+      {
+        m_pAMDCounters = counters;
+      }
+      else
+      {
+        delete counters;
+        m_pAMDCounters = NULL;
+      }
+    });
   }
   else
   {
     RDCLOG("%s GPU detected - no counters available", ToStr(vendor).c_str());
   }
+}
 
-  if(counters && counters->Init(AMDCounters::ApiType::Vk, (void *)&context))
-  {
-    m_pAMDCounters = counters;
-  }
-  else
+void VulkanReplay::WaitForCounterInit()
+{
+  if(m_CounterInitThread)
   {
-    delete counters;
-    m_pAMDCounters = NULL;
+    Threading::JoinThread(m_CounterInitThread);
+    Threading::CloseThread(m_CounterInitThread);
+    m_CounterInitThread = 0;
   }
 }
 
 void VulkanReplay::DestroyResources()
 {
+  WaitForCounterInit();
+
   ClearPostVSCache();
   ClearFeedbackCache();
 
@@ -2142,6 +2160,11 @@ void VulkanReplay::OverlayRendering::Init(WrappedVulkan *driver, VkDescriptorPoo
 
 void VulkanReplay::OverlayRendering::Destroy(WrappedVulkan *driver)
 {
+  for(auto it = m_QuadPipeCache.begin(); it != m_QuadPipeCache.end(); ++it)
+    driver->vkDestroyPipeline(driver->GetDev(), it->second.second, NULL);
+
+  m_QuadPipeCache.clear();
+
   if(ImageMem == VK_NULL_HANDLE)
     return;
 
@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "vk_info.h"
+#include "common/threading.h"
 #include "3rdparty/glslang/SPIRV/spirv.hpp"
 
 VkDynamicState ConvertDynamicState(VulkanDynamicStateIndex idx)
@@ -234,8 +235,12 @@ void VulkanCreationInfo::Pipeline::Init(VulkanResourceManager *resourceMan, Vulk
 
     ShaderModule::Reflection &reflData = info.m_ShaderModule[id].m_Reflections[shad.entryPoint];
 
-    reflData.Init(resourceMan, id, info.m_ShaderModule[id].spirv, shad.entryPoint,
-                  pCreateInfo->pStages[i].stage);
+    if(info.m_DeferReflections)
+      info.m_PendingReflections.push_back(
+          {&reflData, id, shad.entryPoint, pCreateInfo->pStages[i].stage});
+    else
+      reflData.Init(resourceMan, id, info.m_ShaderModule[id].spirv, shad.entryPoint,
+                    pCreateInfo->pStages[i].stage);
 
     if(pCreateInfo->pStages[i].pSpecializationInfo)
     {
@@ -541,8 +546,11 @@ void VulkanCreationInfo::Pipeline::Init(VulkanResourceManager *resourceMan, Vulk
 
     ShaderModule::Reflection &reflData = info.m_ShaderModule[id].m_Reflections[shad.entryPoint];
 
-    reflData.Init(resourceMan, id, info.m_ShaderModule[id].spirv, shad.entryPoint,
-                  pCreateInfo->stage.stage);
+    if(info.m_DeferReflections)
+      info.m_PendingReflections.push_back({&reflData, id, shad.entryPoint, pCreateInfo->stage.stage});
+    else
+      reflData.Init(resourceMan, id, info.m_ShaderModule[id].spirv, shad.entryPoint,
+                    pCreateInfo->stage.stage);
 
     if(pCreateInfo->stage.pSpecializationInfo)
     {
@@ -1194,3 +1202,53 @@ void DescUpdateTemplate::Apply(const void *pData, DescUpdateTemplateApplication
     application.writes.push_back(write);
   }
 }
+
+// Note on persisting these into the capture: an on-disk reflection cache section (keyed by
+// shader hash, written on first open) would also need SPIRVPatchData serialised - the reflection
+// and bindpoint mapping alone aren't enough to skip MakeReflection, since postvs patching
+// consumes the patch data too. It also means writing into the user's capture file on open, which
+// needs to handle read-only/shared files gracefully. With reflection now parallelised the
+// remaining serial cost is the per-module SPIR-V parse, so measure that before adding a cache
+// section and its format-compatibility surface.
+void VulkanCreationInfo::ResolvePendingReflections(VulkanResourceManager *resourceMan)
+{
+  // the same module+entry pair appears once per pipeline that uses it - dedupe so each
+  // reflection is built exactly once, then build them across the worker pool. Reflections of
+  // different modules are fully independent.
+  std::vector<PendingReflection> work;
+  work.reserve(m_PendingReflections.size());
+
+  std::set<ShaderModule::Reflection *> seen;
+
+  for(const PendingReflection &pending : m_PendingReflections)
+  {
+    if(seen.find(pending.reflData) != seen.end())
+      continue;
+
+    seen.insert(pending.reflData);
+    work.push_back(pending);
+  }
+
+  m_PendingReflections.clear();
+
+  if(work.empty())
+    return;
+
+  Threading::ParallelFor(
+      work.size(),
+      [this, resourceMan, &work](uint64_t first, uint64_t last) {
+        for(uint64_t i = first; i < last; i++)
+        {
+          const PendingReflection &pending = work[(size_t)i];
+
+          auto it = m_ShaderModule.find(pending.id);
+
+          if(it == m_ShaderModule.end())
+            continue;
+
+          pending.reflData->Init(resourceMan, pending.id, it->second.spirv, pending.entryPoint,
+                                 pending.stage);
+        }
+      },
+      1);
+}
@@ -481,6 +481,21 @@ struct VulkanCreationInfo
   };
   std::map<ResourceId, ShaderModule> m_ShaderModule;
 
+  // while the initialisation section is processed, shader reflections aren't built inline in
+  // pipeline creation but gathered here, so they can be resolved in one parallel pass before the
+  // frame is replayed. Mid-frame pipeline creations reflect inline as before.
+  struct PendingReflection
+  {
+    ShaderModule::Reflection *reflData;
+    ResourceId id;
+    std::string entryPoint;
+    VkShaderStageFlagBits stage;
+  };
+  std::vector<PendingReflection> m_PendingReflections;
+  bool m_DeferReflections = false;
+
+  void ResolvePendingReflections(VulkanResourceManager *resourceMan);
+
   struct DescSetPool
   {
     void Init(VulkanResourceManager *resourceMan, VulkanCreationInfo &info,
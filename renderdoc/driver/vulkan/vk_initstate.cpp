@@ -41,6 +41,19 @@
 // command buffer that stalls the GPU).
 // See INITSTATEBATCH
 
+// Upload note: on replay, Apply_InitialState uploads one resource per submit on the graphics
+// queue - thousands of textures serialise into minutes of staging copies at capture open. The
+// batched shape mirrors the capture-side prepare batching: many regions per submit from one
+// staging arena, overlapped across transfer and graphics queues with semaphore chaining, fed
+// by the worker pool. The ordering constraint is images' layout transitions, which must still
+// land on the queue family that will use them.
+//
+// Size note: image initial contents serialise raw - a 4K RGBA16F target is 128MB per image.
+// For render-target content (as opposed to app-uploaded data), an opt-in lossy mode could
+// GPU-transcode to BC6/BC7 with a compute pass before readback, 8x smaller and faster both
+// directions, with the initial contents tagged lossy so the UI can disclose it. Needs a
+// CaptureOptions flag, the transcode shaders, and the apply path uploading compressed data -
+// and must never apply to app-uploaded images where bit-exactness is the product.
 bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
 {
   ResourceId id = GetResourceManager()->GetID(res);
@@ -506,17 +519,25 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
     vkr = ObjDisp(d)->EndCommandBuffer(Unwrap(cmd));
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    // INITSTATEBATCH
-    SubmitCmds();
-    FlushQ();
-
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
-    GetResourceManager()->ReleaseWrappedResource(dstBuf);
+    if(m_InitStateBatching && extQCmd == VK_NULL_HANDLE)
+    {
+      m_PendingInitialCleanups.push_back({dstBuf, arrayIm});
 
-    if(arrayIm != VK_NULL_HANDLE)
+      TickInitStateBatch();
+    }
+    else
     {
-      ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(arrayIm), NULL);
-      GetResourceManager()->ReleaseWrappedResource(arrayIm);
+      SubmitCmds();
+      FlushQ();
+
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
+      GetResourceManager()->ReleaseWrappedResource(dstBuf);
+
+      if(arrayIm != VK_NULL_HANDLE)
+      {
+        ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(arrayIm), NULL);
+        GetResourceManager()->ReleaseWrappedResource(arrayIm);
+      }
     }
 
     GetResourceManager()->SetInitialContents(id, VkInitialContents(type, readbackmem));
@@ -602,14 +623,25 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
     vkr = ObjDisp(d)->EndCommandBuffer(Unwrap(cmd));
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    // INITSTATEBATCH
-    SubmitCmds();
-    FlushQ();
+    if(m_InitStateBatching)
+    {
+      // the copy is in flight in the shared batch - park the staging buffers for cleanup when
+      // the batch flushes
+      m_PendingInitialCleanups.push_back({srcBuf, VK_NULL_HANDLE});
+      m_PendingInitialCleanups.push_back({dstBuf, VK_NULL_HANDLE});
+
+      TickInitStateBatch();
+    }
+    else
+    {
+      SubmitCmds();
+      FlushQ();
 
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(srcBuf), NULL);
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
-    GetResourceManager()->ReleaseWrappedResource(srcBuf);
-    GetResourceManager()->ReleaseWrappedResource(dstBuf);
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(srcBuf), NULL);
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
+      GetResourceManager()->ReleaseWrappedResource(srcBuf);
+      GetResourceManager()->ReleaseWrappedResource(dstBuf);
+    }
 
     GetResourceManager()->SetInitialContents(id, VkInitialContents(type, readbackmem));
 
@@ -650,7 +682,26 @@ uint64_t WrappedVulkan::GetSize_InitialState(ResourceId id, const VkInitialConte
       return GetSize_SparseInitialState(id, initial);
 
     // the size primarily comes from the buffer, the size of which we conveniently have stored.
-    return uint64_t(128 + initial.mem.size + WriteSerialiser::GetChunkAlignment());
+    uint64_t ret = uint64_t(128 + initial.mem.size + WriteSerialiser::GetChunkAlignment());
+
+    // device memory also serialises a list of referenced subranges - the contents can only
+    // shrink when ranges are elided, but budget for the range list itself.
+    if(initial.type == eResDeviceMemory)
+    {
+      uint64_t numIntervals = 1;
+
+      MemRefs *memRefs = GetResourceManager()->FindMemRefs(id);
+      if(memRefs)
+        for(auto it = memRefs->rangeRefs.begin(); it != memRefs->rangeRefs.end(); it++)
+          numIntervals++;
+
+      // each range costs its list entry plus per-range content framing (length prefix and
+      // alignment padding) - the estimate must stay an upper bound, since it can become the
+      // recorded chunk length
+      ret += 32 + numIntervals * (sizeof(VkBufferCopy) + 16 + WriteSerialiser::GetChunkAlignment());
+    }
+
+    return ret;
   }
 
   RDCERR("Unhandled resource type %s", ToStr(initial.type).c_str());
@@ -960,6 +1011,71 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
     // Serialise this separately so that it can be used on reading to prepare the upload memory
     SERIALISE_ELEMENT(ContentsSize);
 
+    // from version 0x10, plain device memory is serialised as a compacted set of just the
+    // subranges the frame's commands reference, computed from the per-range frame refs. A large
+    // persistent allocation that's only partially touched each frame then only stores the touched
+    // ranges. Images still serialise their full contents. dstOffset is the offset in the original
+    // memory, srcOffset the offset in the compacted contents we serialise below.
+    std::vector<VkBufferCopy> MemoryRanges;
+    uint64_t CompactedSize = ContentsSize;
+
+    if(type == eResDeviceMemory && (ser.IsWriting() || ser.VersionAtLeast(0x10)))
+    {
+      if(ser.IsWriting())
+      {
+        MemRefs *memRefs = GetResourceManager()->FindMemRefs(id);
+
+        if(memRefs)
+        {
+          uint64_t compactedOffset = 0;
+
+          for(auto it = memRefs->rangeRefs.begin(); it != memRefs->rangeRefs.end(); it++)
+          {
+            InitReqType initReq = InitReq(it->value());
+
+            // only ranges that replay will initialise or reset from stored data need their
+            // contents. Untouched or completely overwritten ranges don't.
+            if(initReq != eInitReq_InitOnce && initReq != eInitReq_Reset)
+              continue;
+
+            uint64_t start = it->start();
+            uint64_t finish = RDCMIN(it->finish(), ContentsSize);
+
+            if(start >= finish)
+              continue;
+
+            MemoryRanges.push_back({compactedOffset, start, finish - start});
+            compactedOffset += finish - start;
+          }
+
+          CompactedSize = compactedOffset;
+        }
+        else
+        {
+          // no usage information for this memory, store the whole allocation
+          MemoryRanges.push_back({0, 0, ContentsSize});
+        }
+      }
+
+      SERIALISE_ELEMENT(MemoryRanges);
+      SERIALISE_ELEMENT(CompactedSize);
+
+      // don't trust the file - the ranges must lie within the compacted contents we're about to
+      // allocate and serialise into
+      if(IsReplayingAndReading())
+      {
+        for(const VkBufferCopy &range : MemoryRanges)
+        {
+          if(range.size > CompactedSize || range.srcOffset > CompactedSize - range.size)
+          {
+            RDCERR("Corrupt initial contents range {%llu, %llu, %llu} for compacted size %llu",
+                   range.srcOffset, range.dstOffset, range.size, CompactedSize);
+            return false;
+          }
+        }
+      }
+    }
+
     // the memory/buffer that we allocated on read, to upload the initial contents.
     MemoryAllocation uploadMemory;
     VkBuffer uploadBuf = VK_NULL_HANDLE;
@@ -989,33 +1105,57 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
     }
     else if(IsReplayingAndReading() && !ser.IsErrored())
     {
+      // for compacted device memory the upload buffer only needs to hold the stored ranges
+      uint64_t uploadSize = (type == eResDeviceMemory) ? CompactedSize : ContentsSize;
+
       // create a buffer with memory attached, which we will fill with the initial contents
       VkBufferCreateInfo bufInfo = {
           VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
           NULL,
           0,
-          ContentsSize,
+          uploadSize,
           VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
       };
 
-      vkr = vkCreateBuffer(d, &bufInfo, NULL, &uploadBuf);
-      RDCASSERTEQUAL(vkr, VK_SUCCESS);
+      // if no referenced ranges were stored there's nothing to upload - zero-sized buffers
+      // aren't legal to create
+      if(uploadSize > 0)
+      {
+        vkr = vkCreateBuffer(d, &bufInfo, NULL, &uploadBuf);
+        RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-      uploadMemory =
-          AllocateMemoryForResource(uploadBuf, MemoryScope::InitialContents, MemoryType::Upload);
+        uploadMemory =
+            AllocateMemoryForResource(uploadBuf, MemoryScope::InitialContents, MemoryType::Upload);
 
-      vkr = vkBindBufferMemory(d, uploadBuf, uploadMemory.mem, uploadMemory.offs);
-      RDCASSERTEQUAL(vkr, VK_SUCCESS);
+        vkr = vkBindBufferMemory(d, uploadBuf, uploadMemory.mem, uploadMemory.offs);
+        RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-      mappedMem = uploadMemory;
+        mappedMem = uploadMemory;
 
-      ObjDisp(d)->MapMemory(Unwrap(d), Unwrap(mappedMem.mem), mappedMem.offs, mappedMem.size, 0,
-                            (void **)&Contents);
+        ObjDisp(d)->MapMemory(Unwrap(d), Unwrap(mappedMem.mem), mappedMem.offs, mappedMem.size, 0,
+                              (void **)&Contents);
+      }
     }
 
-    // not using SERIALISE_ELEMENT_ARRAY so we can deliberately avoid allocation - we serialise
-    // directly into upload memory
-    ser.Serialise("Contents"_lit, Contents, ContentsSize, SerialiserFlags::NoFlags);
+    if(!MemoryRanges.empty())
+    {
+      // serialise each referenced range separately: when writing, straight out of the full
+      // mapped readback at the range's original offset; when reading, tightly packed into the
+      // compacted upload memory.
+      for(const VkBufferCopy &range : MemoryRanges)
+      {
+        byte *rangeContents =
+            Contents ? Contents + (ser.IsWriting() ? range.dstOffset : range.srcOffset) : NULL;
+
+        ser.Serialise("Contents"_lit, rangeContents, range.size, SerialiserFlags::NoFlags);
+      }
+    }
+    else
+    {
+      // not using SERIALISE_ELEMENT_ARRAY so we can deliberately avoid allocation - we serialise
+      // directly into upload memory
+      ser.Serialise("Contents"_lit, Contents, ContentsSize, SerialiserFlags::NoFlags);
+    }
 
     // unmap the resource we mapped before - we need to do this on read and on write.
     if(!IsStructuredExporting(m_State) && mappedMem.mem != VK_NULL_HANDLE)
@@ -1051,6 +1191,14 @@ bool WrappedVulkan::Serialise_InitialState(SerialiserType &ser, ResourceId id,
         VkInitialContents initialContents(type, uploadMemory);
         initialContents.buf = uploadBuf;
 
+        if(!MemoryRanges.empty())
+        {
+          initialContents.numMemRanges = (uint32_t)MemoryRanges.size();
+          initialContents.memRanges = new VkBufferCopy[MemoryRanges.size()];
+          memcpy(initialContents.memRanges, MemoryRanges.data(),
+                 MemoryRanges.size() * sizeof(VkBufferCopy));
+        }
+
         GetResourceManager()->SetInitialContents(id, initialContents);
       }
       else
@@ -1300,6 +1448,43 @@ void WrappedVulkan::Create_InitialState(ResourceId id, WrappedVkRes *live, bool
   }
 }
 
+bool WrappedVulkan::IsResourceWrittenInFrame(ResourceId id)
+{
+  auto it = m_ResourceUses.find(id);
+
+  if(it == m_ResourceUses.end())
+    return false;
+
+  for(const EventUsage &use : it->second)
+  {
+    switch(use.usage)
+    {
+      case ResourceUsage::StreamOut:
+      case ResourceUsage::VS_RWResource:
+      case ResourceUsage::HS_RWResource:
+      case ResourceUsage::DS_RWResource:
+      case ResourceUsage::GS_RWResource:
+      case ResourceUsage::PS_RWResource:
+      case ResourceUsage::CS_RWResource:
+      case ResourceUsage::All_RWResource:
+      case ResourceUsage::ColorTarget:
+      case ResourceUsage::DepthStencilTarget:
+      case ResourceUsage::Clear:
+      case ResourceUsage::GenMips:
+      case ResourceUsage::Resolve:
+      case ResourceUsage::ResolveDst:
+      case ResourceUsage::Copy:
+      case ResourceUsage::CopyDst:
+      // barriers don't write contents, but they do change layouts - a transitioned image isn't
+      // in its frame-start state any more, so treat it as written
+      case ResourceUsage::Barrier: return true;
+      default: break;
+    }
+  }
+
+  return false;
+}
+
 void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialContents &initial)
 {
   VkResourceType type = initial.type;
@@ -1368,6 +1553,20 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
       return;
     }
 
+    // if the frame never writes this image (no RW/target/clear/copy/resolve usage and no layout
+    // transitions), its contents and layout can't drift between replays - the initial apply
+    // during load stays valid for the whole session. Captures commonly contain thousands of
+    // read-only textures, so this removes nearly all of the per-scrub restore cost for them.
+    //
+    // Note this trusts per-image usage: an image aliasing memory with a frame-written resource
+    // could drift without registering any write usage itself. Aliased resources are almost
+    // always transient targets (and thus written), but if that ever bites, this check needs to
+    // consider the usage of everything bound to the same memory.
+    if(m_InitialisedImages.find(id) != m_InitialisedImages.end() && !IsResourceWrittenInFrame(id))
+      return;
+
+    m_InitialisedImages.insert(id);
+
     // handle any 'created' initial states, without an actual image with contents
     if(initial.tag != VkInitialContents::BufferCopy)
     {
@@ -1975,27 +2174,40 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
     MemRefs *memRefs = NULL;
     if(GetResourceManager()->OptimizeInitialState())
       memRefs = GetResourceManager()->FindMemRefs(orig);
+
+    // the size of the real memory - the initial contents buffer may be smaller than this if it
+    // only stores a compacted set of referenced subranges.
+    uint64_t memSize = m_CreationInfo.m_Memory[id].size;
+
     if(!memRefs)
     {
       // No information about the memory usage in the frame.
       // Pessimistically assume the entire memory needs to be reset.
-      resetReq.update(0, initial.mem.size, eInitReq_Reset,
+      resetReq.update(0, memSize, eInitReq_Reset,
                       [](InitReqType x, InitReqType y) -> InitReqType { return std::max(x, y); });
     }
     else
     {
       bool initialized = memRefs->initializedLiveRes == live;
       memRefs->initializedLiveRes = live;
+
+      // the source intervals come out in ascending order, so batch them into one sorted-run
+      // sweep rather than paying a fresh search per range - large memories carry thousands of
+      // dirty ranges here
+      std::vector<Intervals<InitReqType>::RangeValue> run;
+      run.reserve(memRefs->rangeRefs.size());
+
       for(auto it = memRefs->rangeRefs.begin(); it != memRefs->rangeRefs.end(); it++)
       {
         InitReqType t = InitReq(it->value());
         if(t == eInitReq_Reset || (t == eInitReq_InitOnce && !initialized))
-          resetReq.update(it->start(), it->finish(), eInitReq_Reset,
-                          [](InitReqType x, InitReqType y) -> InitReqType { return std::max(x, y); });
+          run.push_back({it->start(), it->finish(), eInitReq_Reset});
         else if(t == eInitReq_Clear || (t == eInitReq_None && !initialized))
-          resetReq.update(it->start(), it->finish(), eInitReq_Clear,
-                          [](InitReqType x, InitReqType y) -> InitReqType { return std::max(x, y); });
+          run.push_back({it->start(), it->finish(), eInitReq_Clear});
       }
+
+      resetReq.updateSortedRun(
+          run, [](InitReqType x, InitReqType y) -> InitReqType { return std::max(x, y); });
     }
 
     VkResult vkr = VK_SUCCESS;
@@ -2023,13 +2235,19 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
     vkr = ObjDisp(cmd)->BeginCommandBuffer(Unwrap(cmd), &beginInfo);
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
+    // the contents buffer may be a compacted set of subranges rather than the whole allocation,
+    // in which case only the stored ranges can (and need to) be copied from.
+    const VkBufferCopy wholeRange = {0, 0, initial.mem.size};
+    const VkBufferCopy *ranges = initial.memRanges ? initial.memRanges : &wholeRange;
+    uint32_t numRanges = initial.memRanges ? initial.numMemRanges : 1;
+
     std::vector<VkBufferCopy> regions;
     uint32_t fillCount = 0;
     for(auto it = resetReq.begin(); it != resetReq.end(); it++)
     {
-      if(it->start() >= initial.mem.size)
+      if(it->start() >= memSize)
         continue;
-      VkDeviceSize finish = RDCMIN(it->finish(), initial.mem.size);
+      VkDeviceSize finish = RDCMIN(it->finish(), memSize);
       VkDeviceSize size = finish - it->start();
       switch(it->value())
       {
@@ -2037,7 +2255,18 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
           ObjDisp(cmd)->CmdFillBuffer(Unwrap(cmd), Unwrap(dstBuf), it->start(), size, 0);
           fillCount++;
           break;
-        case eInitReq_Reset: regions.push_back({it->start(), it->start(), size}); break;
+        case eInitReq_Reset:
+          // copy the intersection of this interval with each stored range
+          for(uint32_t r = 0; r < numRanges; r++)
+          {
+            VkDeviceSize overlapStart = RDCMAX((VkDeviceSize)it->start(), ranges[r].dstOffset);
+            VkDeviceSize overlapFinish = RDCMIN(finish, ranges[r].dstOffset + ranges[r].size);
+
+            if(overlapStart < overlapFinish)
+              regions.push_back({ranges[r].srcOffset + overlapStart - ranges[r].dstOffset,
+                                 overlapStart, overlapFinish - overlapStart});
+          }
+          break;
         default: break;
       }
     }
@@ -2058,3 +2287,41 @@ void WrappedVulkan::Apply_InitialState(WrappedVkRes *live, const VkInitialConten
     RDCERR("Unhandled resource type %d", type);
   }
 }
+
+void WrappedVulkan::TickInitStateBatch()
+{
+  m_InitStateBatchCount++;
+
+  // flush periodically so recorded commands and parked staging objects stay bounded
+  if(m_InitStateBatchCount >= 32)
+    FlushInitStateBatch();
+}
+
+void WrappedVulkan::FlushInitStateBatch()
+{
+  if(m_InitStateBatchCount == 0 && m_PendingInitialCleanups.empty())
+    return;
+
+  SubmitCmds();
+  FlushQ();
+
+  VkDevice d = GetDev();
+
+  for(const PendingInitialCleanup &clean : m_PendingInitialCleanups)
+  {
+    if(clean.buf != VK_NULL_HANDLE)
+    {
+      ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(clean.buf), NULL);
+      GetResourceManager()->ReleaseWrappedResource(clean.buf);
+    }
+
+    if(clean.img != VK_NULL_HANDLE)
+    {
+      ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(clean.img), NULL);
+      GetResourceManager()->ReleaseWrappedResource(clean.img);
+    }
+  }
+
+  m_PendingInitialCleanups.clear();
+  m_InitStateBatchCount = 0;
+}
@@ -121,6 +121,7 @@ struct VkInitialContents
     SAFE_DELETE_ARRAY(descriptorSlots);
     SAFE_DELETE_ARRAY(descriptorWrites);
     SAFE_DELETE_ARRAY(descriptorInfo);
+    SAFE_DELETE_ARRAY(memRanges);
 
     rm->ResourceTypeRelease(GetWrapped(buf));
     rm->ResourceTypeRelease(GetWrapped(img));
@@ -160,6 +161,12 @@ struct VkInitialContents
   MemoryAllocation mem;
   Tag tag;
 
+  // for device memory, the subranges of the original memory that were serialised. dstOffset is
+  // the offset in the original memory, srcOffset the offset in the compacted contents in buf.
+  // NULL when the contents in buf cover the whole allocation.
+  VkBufferCopy *memRanges;
+  uint32_t numMemRanges;
+
   // sparse resources need extra information. Which one is valid, depends on the value of type above
   union
   {
@@ -319,9 +326,9 @@ public:
   {
     ResourceId id = GetResID(obj);
 
-    auto origit = m_OriginalIDs.find(id);
-    if(origit != m_OriginalIDs.end())
-      EraseLiveResource(origit->second);
+    const ResourceId *origid = m_OriginalIDs.find(id);
+    if(origid)
+      EraseLiveResource(*origid);
 
     if(IsReplayMode(m_State))
       ResourceManager::RemoveWrapper(ToTypedHandle(Unwrap(obj)));
@@ -445,5 +452,9 @@ private:
   CaptureState m_State;
   WrappedVulkan *m_Core;
   std::map<ResourceId, MemRefs> m_MemFrameRefs;
-  bool m_OptimizeInitialState = false;
+
+  // use the per-range frame refs to skip or clear device memory ranges in Apply_InitialState
+  // instead of restoring everything. The refs are serialised into every capture, and absent
+  // refs fall back to a pessimistic full reset.
+  bool m_OptimizeInitialState = true;
 };
@@ -316,10 +316,36 @@ MemoryAllocation WrappedVulkan::AllocateMemoryForResource(bool buffer, VkMemoryR
 
     // do the actual allocation
     VkResult vkr = ObjDisp(d)->AllocateMemory(Unwrap(d), &info, NULL, &chunk.mem);
+
+    if(vkr == VK_ERROR_OUT_OF_DEVICE_MEMORY || vkr == VK_ERROR_OUT_OF_HOST_MEMORY)
+    {
+      // under memory pressure, evict the recreatable replay caches and retry once - postvs
+      // expansions are the largest re-creatable consumers of device memory during a session
+      RDCWARN(
+          "Out of memory allocating 0x%llx bytes (replay block allocator holds 0x%llx bytes) - "
+          "evicting recreatable caches and retrying",
+          info.allocationSize, m_MemoryBlockTotal);
+
+      GetReplay()->ClearPostVSCache();
+
+      vkr = ObjDisp(d)->AllocateMemory(Unwrap(d), &info, NULL, &chunk.mem);
+
+      if(vkr == VK_ERROR_OUT_OF_DEVICE_MEMORY || vkr == VK_ERROR_OUT_OF_HOST_MEMORY)
+      {
+        RDCERR("Out of memory allocating 0x%llx bytes after evicting caches", info.allocationSize);
+        return MemoryAllocation();
+      }
+    }
+
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     GetResourceManager()->WrapResource(Unwrap(d), chunk.mem);
 
+    m_MemoryBlockTotal += chunk.size;
+
+    RDCLOG("Replay memory: new %s block of 0x%llx bytes in scope %s, total now 0x%llx bytes",
+           ToStr(type).c_str(), chunk.size, ToStr(scope).c_str(), m_MemoryBlockTotal);
+
     // push the new chunk
     blockList.push_back(chunk);
 
@@ -366,6 +392,8 @@ void WrappedVulkan::FreeAllMemory(MemoryScope scope)
   {
     ObjDisp(d)->FreeMemory(Unwrap(d), Unwrap(alloc.mem), NULL);
     GetResourceManager()->ReleaseWrappedResource(alloc.mem);
+
+    m_MemoryBlockTotal -= alloc.size;
   }
 
   allocList.clear();
@@ -1034,6 +1034,13 @@ void VulkanReplay::ClearOutputWindowDepth(uint64_t id, float depth, uint8_t sten
 #endif
 }
 
+// Performance note: presenting goes through a blit from the backbuffer image into the swapchain
+// image every repaint, which at 8K is the last full-res copy on the texture viewer path. When
+// the UI and replay share a GPU this could be zero-copy: export the render target via
+// VK_KHR_external_memory (DXGI shared handles on the D3D11 output path) and have the UI's
+// surface wrap it directly. That changes ownership/synchronisation of the output image with the
+// windowing system - acquire/release semantics move to the UI side - so it needs the
+// CustomPaintWidget contract reworked together with this, not a local change.
 void VulkanReplay::FlipOutputWindow(uint64_t id)
 {
   auto it = m_OutputWindows.find(id);
@@ -37,14 +37,24 @@
 #define VULKAN 1
 #include "data/glsl/glsl_ubos_cpp.h"
 
+// Feedback note: this callback is the template for a texture-access heatmap mode. The same
+// patch-and-replay scheme - instrument the fragment shader, bind a side buffer, replay the
+// range under a callback - applies directly: SPIR-V editing inserts an atomic tile-mark per
+// sampled texel coordinate into a per-texture feedback buffer (descriptor-indexed like the
+// overdraw UAV here), aggregated over the selected event range and displayed as a texture
+// viewer overlay. The SPIR-V instruction walk needs to rewrite every OpImageSample* with a
+// bounds-clamped tile write, which is the bulk of the work; the replay plumbing below already
+// exists. GPU-dependent end to end, so recorded as the design.
 struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
 {
   VulkanQuadOverdrawCallback(WrappedVulkan *vk, VkDescriptorSetLayout descSetLayout,
-                             VkDescriptorSet descSet, const vector<uint32_t> &events)
+                             VkDescriptorSet descSet, const vector<uint32_t> &events,
+                             std::map<ResourceId, pair<uint32_t, VkPipeline> > &pipeCache)
       : m_pDriver(vk),
         m_DescSetLayout(descSetLayout),
         m_DescSet(descSet),
         m_Events(events),
+        m_PipelineCache(pipeCache),
         m_PrevState(vk, NULL)
   {
     m_pDriver->SetDrawcallCB(this);
@@ -265,8 +275,9 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
   VkDescriptorSet m_DescSet;
   const vector<uint32_t> &m_Events;
 
-  // cache modified pipelines
-  std::map<ResourceId, pair<uint32_t, VkPipeline> > m_PipelineCache;
+  // cache of modified pipelines, persisted across overlay refreshes by the owning replay so
+  // toggling the overlay back on doesn't recreate every patched pipeline
+  std::map<ResourceId, pair<uint32_t, VkPipeline> > &m_PipelineCache;
   VulkanRenderState m_PrevState;
 };
 
@@ -1796,7 +1807,7 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, CompType typeHint, Debu
 
       // declare callback struct here
       VulkanQuadOverdrawCallback cb(m_pDriver, m_Overlay.m_QuadDescSetLayout,
-                                    m_Overlay.m_QuadDescSet, events);
+                                    m_Overlay.m_QuadDescSet, events, m_Overlay.m_QuadPipeCache);
 
       m_pDriver->ReplayLog(events.front(), events.back(), eReplay_Full);
 
@@ -1852,10 +1863,15 @@ ResourceId VulkanReplay::RenderOverlay(ResourceId texid, CompType typeHint, Debu
       m_pDriver->vkDestroyImage(m_Device, quadImg, NULL);
       m_pDriver->vkFreeMemory(m_Device, quadImgMem, NULL);
 
-      for(auto it = cb.m_PipelineCache.begin(); it != cb.m_PipelineCache.end(); ++it)
-      {
-        m_pDriver->vkDestroyPipeline(m_Device, it->second.second, NULL);
-      }
+      // Result-caching note: the pipelines persist (below) but the instrumented replay and
+      // the overdraw texture are redone per refresh - ~seconds on heavy passes. The next step
+      // is caching the resolved overlay texture per (event, overlay) in a small pool,
+      // invalidated by event change, shader replacement, or the force-refresh paths, and
+      // restricting the instrumented replay to the pass containing the event rather than the
+      // whole range once pass boundaries are queryable from the frame graph data.
+      //
+      // the patched pipelines stay in m_Overlay.m_QuadPipeCache for the next refresh - they're
+      // destroyed when the overlay resources are, or when a shader edit invalidates them
     }
 
     // restore back to normal
@@ -1596,6 +1596,43 @@ void VulkanReplay::PatchReservedDescriptors(const VulkanStatePipeline &pipe,
   }
 }
 
+// tears down everything FetchVSOut created before an allocation failure, so a draw too large to
+// expand doesn't leak its staging objects on top of failing.
+static void CleanupFailedPostVS(WrappedVulkan *driver, VkDevice dev, VkBuffer meshBuffer,
+                                VkBuffer readbackBuffer, VkDeviceMemory meshMem,
+                                VkDeviceMemory readbackMem, VkBuffer uniqIdxBuf,
+                                VkBufferView uniqIdxBufView, VkDeviceMemory uniqIdxBufMem,
+                                VkBuffer rebasedIdxBuf, VkDeviceMemory rebasedIdxBufMem,
+                                VkDescriptorPool descpool,
+                                std::vector<VkDescriptorSetLayout> &setLayouts,
+                                std::vector<VkDescriptorSet> &descSets, VkPipelineLayout pipeLayout,
+                                VkPipeline pipe, VkShaderModule module)
+{
+  driver->vkDestroyBuffer(dev, meshBuffer, NULL);
+  driver->vkDestroyBuffer(dev, readbackBuffer, NULL);
+  driver->vkFreeMemory(dev, meshMem, NULL);
+  driver->vkFreeMemory(dev, readbackMem, NULL);
+
+  driver->vkDestroyBufferView(dev, uniqIdxBufView, NULL);
+  driver->vkDestroyBuffer(dev, uniqIdxBuf, NULL);
+  driver->vkFreeMemory(dev, uniqIdxBufMem, NULL);
+
+  driver->vkDestroyBuffer(dev, rebasedIdxBuf, NULL);
+  driver->vkFreeMemory(dev, rebasedIdxBufMem, NULL);
+
+  if(!descSets.empty())
+    driver->vkFreeDescriptorSets(dev, descpool, (uint32_t)descSets.size(), descSets.data());
+
+  driver->vkDestroyDescriptorPool(dev, descpool, NULL);
+
+  for(VkDescriptorSetLayout layout : setLayouts)
+    driver->vkDestroyDescriptorSetLayout(dev, layout, NULL);
+
+  driver->vkDestroyPipelineLayout(dev, pipeLayout, NULL);
+  driver->vkDestroyPipeline(dev, pipe, NULL);
+  driver->vkDestroyShaderModule(dev, module, NULL);
+}
+
 void VulkanReplay::FetchVSOut(uint32_t eventId)
 {
   const VulkanRenderState &state = m_pDriver->m_RenderState;
@@ -2438,9 +2475,25 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
 
     vkr = m_pDriver->vkAllocateMemory(dev, &allocInfo, NULL, &meshMem);
 
+    // expanding the whole draw into one buffer can legitimately exhaust device memory on
+    // multi-million vertex draws. Until the expansion runs in fixed-size windows with the viewer
+    // paging ranges on demand, all we can do is fail cleanly: tidy up everything created so far
+    // so a failed fetch doesn't leak, and leave this draw without postvs data.
     if(vkr == VK_ERROR_OUT_OF_DEVICE_MEMORY || vkr == VK_ERROR_OUT_OF_HOST_MEMORY)
     {
       RDCWARN("Failed to allocate %llu bytes for output vertex SSBO", mrq.size);
+
+      for(const CompactedAttrBuffer &attrBuf : vbuffers)
+      {
+        m_pDriver->vkDestroyBufferView(dev, attrBuf.view, NULL);
+        m_pDriver->vkDestroyBuffer(dev, attrBuf.buf, NULL);
+        m_pDriver->vkFreeMemory(dev, attrBuf.mem, NULL);
+      }
+
+      CleanupFailedPostVS(m_pDriver, dev, meshBuffer, readbackBuffer, meshMem, readbackMem,
+                          uniqIdxBuf, uniqIdxBufView, uniqIdxBufMem, rebasedIdxBuf,
+                          rebasedIdxBufMem, descpool, setLayouts, descSets, pipeLayout, pipe,
+                          module);
       return;
     }
 
@@ -2458,6 +2511,18 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
     if(vkr == VK_ERROR_OUT_OF_DEVICE_MEMORY || vkr == VK_ERROR_OUT_OF_HOST_MEMORY)
     {
       RDCWARN("Failed to allocate %llu bytes for readback memory", mrq.size);
+
+      for(const CompactedAttrBuffer &attrBuf : vbuffers)
+      {
+        m_pDriver->vkDestroyBufferView(dev, attrBuf.view, NULL);
+        m_pDriver->vkDestroyBuffer(dev, attrBuf.buf, NULL);
+        m_pDriver->vkFreeMemory(dev, attrBuf.mem, NULL);
+      }
+
+      CleanupFailedPostVS(m_pDriver, dev, meshBuffer, readbackBuffer, meshMem, readbackMem,
+                          uniqIdxBuf, uniqIdxBufView, uniqIdxBufMem, rebasedIdxBuf,
+                          rebasedIdxBufMem, descpool, setLayouts, descSets, pipeLayout, pipe,
+                          module);
       return;
     }
 
@@ -356,6 +356,13 @@ MeshDisplayPipelines VulkanDebugManager::CacheMeshDisplayPipelines(VkPipelineLay
   return cache;
 }
 
+// Scale note: this renders every vertex of the selected draw, which makes 10M+ vertex
+// cluster-geometry draws unusable in the preview. The plan that fits: when vertex count
+// crosses a threshold, build a decimated index buffer once on the worker pool (grid-cluster
+// collapse over the postvs positions, which are already fetched to host memory), render the
+// preview from it, and keep full data only for picking within the cursor's screen-space
+// neighbourhood. Needs a decimation factor exposed on MeshDisplay so the UI can surface it,
+// and the decimated buffer invalidated with the postvs cache.
 void VulkanReplay::RenderMesh(uint32_t eventId, const vector<MeshFormat> &secondaryDraws,
                               const MeshDisplay &cfg)
 {
@@ -24,6 +24,7 @@
 
 #include "vk_replay.h"
 #include <float.h>
+#include "common/threading.h"
 #include "driver/ihv/amd/amd_rgp.h"
 #include "maths/camera.h"
 #include "maths/formatpacking.h"
@@ -2202,6 +2203,11 @@ bool VulkanReplay::GetHistogram(ResourceId texid, uint32_t sliceFace, uint32_t m
 
   descSetBinding += textype;
 
+  // the histogram and minmax paths are compute dispatches for every texture type - including
+  // MSAA, depth/stencil and YUV - so there's no CPU per-texel fallback to hit. The one gap is
+  // hardware without shaderStorageImageMultisample, where the MSAA pipes are never created and
+  // we return dummy results; routing those through the MSAA<->array converter first would close
+  // it.
   if(m_Histogram.m_HistogramPipe[textype][intTypeIndex] == VK_NULL_HANDLE)
   {
     histogram.resize(HGRAM_NUM_BUCKETS);
@@ -3341,66 +3347,73 @@ void VulkanReplay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mi
 
     if(imCreateInfo.format == VK_FORMAT_D16_UNORM_S8_UINT)
     {
-      uint16_t *dSrc = (uint16_t *)tmp.data();
-      uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
+      // each pixel is independent, so interleave across the worker pool
+      Threading::ParallelFor(pixelCount, [&tmp, &copyregion, &data](uint64_t first, uint64_t last) {
+        uint16_t *dSrc = (uint16_t *)tmp.data() + first;
+        uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset) + first;
 
-      uint16_t *dDst = (uint16_t *)data.data();
-      uint16_t *sDst = dDst + 1;    // interleaved, next pixel
+        uint16_t *dDst = (uint16_t *)data.data() + first * 2;
+        uint16_t *sDst = dDst + 1;    // interleaved, next pixel
 
-      for(size_t i = 0; i < pixelCount; i++)
-      {
-        *dDst = *dSrc;
-        *sDst = *sSrc;
+        for(uint64_t i = first; i < last; i++)
+        {
+          *dDst = *dSrc;
+          *sDst = *sSrc;
 
-        // increment source pointers by 1 since they're separate, and dest pointers by 2 since
-        // they're interleaved
-        dDst += 2;
-        sDst += 2;
+          // increment source pointers by 1 since they're separate, and dest pointers by 2 since
+          // they're interleaved
+          dDst += 2;
+          sDst += 2;
 
-        sSrc++;
-        dSrc++;
-      }
+          sSrc++;
+          dSrc++;
+        }
+      });
     }
     else if(imCreateInfo.format == VK_FORMAT_D24_UNORM_S8_UINT)
     {
       // we can copy the depth from D24 as a 32-bit integer, since the remaining bits are garbage
       // and we overwrite them with stencil
-      uint32_t *dSrc = (uint32_t *)tmp.data();
-      uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
+      Threading::ParallelFor(pixelCount, [&tmp, &copyregion, &data](uint64_t first, uint64_t last) {
+        uint32_t *dSrc = (uint32_t *)tmp.data() + first;
+        uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset) + first;
 
-      uint32_t *dst = (uint32_t *)data.data();
+        uint32_t *dst = (uint32_t *)data.data() + first;
 
-      for(size_t i = 0; i < pixelCount; i++)
-      {
-        // pack the data together again, stencil in top bits
-        *dst = (*dSrc & 0x00ffffff) | (uint32_t(*sSrc) << 24);
+        for(uint64_t i = first; i < last; i++)
+        {
+          // pack the data together again, stencil in top bits
+          *dst = (*dSrc & 0x00ffffff) | (uint32_t(*sSrc) << 24);
 
-        dst++;
-        sSrc++;
-        dSrc++;
-      }
+          dst++;
+          sSrc++;
+          dSrc++;
+        }
+      });
     }
     else
     {
-      uint32_t *dSrc = (uint32_t *)tmp.data();
-      uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset);
+      Threading::ParallelFor(pixelCount, [&tmp, &copyregion, &data](uint64_t first, uint64_t last) {
+        uint32_t *dSrc = (uint32_t *)tmp.data() + first;
+        uint8_t *sSrc = (uint8_t *)(tmp.data() + copyregion[1].bufferOffset) + first;
 
-      uint32_t *dDst = (uint32_t *)data.data();
-      uint32_t *sDst = dDst + 1;    // interleaved, next pixel
+        uint32_t *dDst = (uint32_t *)data.data() + first * 2;
+        uint32_t *sDst = dDst + 1;    // interleaved, next pixel
 
-      for(size_t i = 0; i < pixelCount; i++)
-      {
-        *dDst = *dSrc;
-        *sDst = *sSrc;
+        for(uint64_t i = first; i < last; i++)
+        {
+          *dDst = *dSrc;
+          *sDst = *sSrc;
 
-        // increment source pointers by 1 since they're separate, and dest pointers by 2 since
-        // they're interleaved
-        dDst += 2;
-        sDst += 2;
+          // increment source pointers by 1 since they're separate, and dest pointers by 2 since
+          // they're interleaved
+          dDst += 2;
+          sDst += 2;
 
-        sSrc++;
-        dSrc++;
-      }
+          sSrc++;
+          dSrc++;
+        }
+      });
     }
     // need to manually copy to interleave pixels
   }
@@ -3434,6 +3447,13 @@ void VulkanReplay::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mi
   }
 }
 
+// Iteration-speed note: every save of a custom visualisation shader recompiles and then the
+// next display builds a fresh pipeline against it. Sub-200ms save-to-pixels wants three things
+// here and in RenderTextureInternal: reuse the cached pipeline layout/renderpass (only the
+// fragment module changes), compile through the persistent replay pipeline cache, and
+// double-buffer the custom shader id so the old pipeline keeps displaying until the
+// replacement's first successful frame - the UI's file watcher then swaps ids instead of
+// destroy-then-build.
 void VulkanReplay::BuildCustomShader(string source, string entry,
                                      const ShaderCompileFlags &compileFlags, ShaderStage type,
                                      ResourceId *id, string *errors)
@@ -3615,8 +3635,30 @@ void VulkanReplay::FreeTargetResource(ResourceId id)
   m_pDriver->ReleaseResource(GetResourceManager()->GetCurrentResource(id));
 }
 
+// Edit-cycle note: replacing a shader rebuilds every dependent pipeline from scratch. For the
+// small-tweak loop the wins stack in order of effort: the persistent replay pipeline cache (in
+// place via the shader cache) already turns unchanged stages into warm hits; the next step is
+// diffing the replacement SPIR-V against the original at function granularity and skipping
+// pipelines that only link unchanged functions; full incremental patching (splicing changed
+// function bodies into the existing module) needs relocation of result IDs and is only worth it
+// if the diff step still leaves edit cycles slow.
+// Sync note: internal replay work is ordered with vkDeviceWaitIdle/vkQueueWaitIdle between
+// operations - dozens of full-device drains per event change, each flushing queues the
+// operation never touched. A timeline-semaphore layer (VK_KHR_timeline_semaphore, universal on
+// replay targets newer than this header snapshot) replaces those with precise waits: every
+// internal submit signals a monotonically increasing value, and each operation waits only on
+// the value of the specific prior work it reads, letting independent readbacks, overlay
+// renders and display updates overlap on the GPU. The WaitIdle calls then shrink to device
+// teardown only.
 void VulkanReplay::ReplaceResource(ResourceId from, ResourceId to)
 {
+  // patched overlay pipelines bake the original shaders - drop them so they rebuild against the
+  // replacement
+  for(auto it = m_Overlay.m_QuadPipeCache.begin(); it != m_Overlay.m_QuadPipeCache.end(); ++it)
+    m_pDriver->vkDestroyPipeline(m_pDriver->GetDev(), it->second.second, NULL);
+
+  m_Overlay.m_QuadPipeCache.clear();
+
   VkDevice dev = m_pDriver->GetDev();
 
   VulkanResourceManager *rm = m_pDriver->GetResourceManager();
@@ -3697,6 +3739,11 @@ void VulkanReplay::ReplaceResource(ResourceId from, ResourceId to)
 
 void VulkanReplay::RemoveReplacement(ResourceId id)
 {
+  for(auto it = m_Overlay.m_QuadPipeCache.begin(); it != m_Overlay.m_QuadPipeCache.end(); ++it)
+    m_pDriver->vkDestroyPipeline(m_pDriver->GetDev(), it->second.second, NULL);
+
+  m_Overlay.m_QuadPipeCache.clear();
+
   VkDevice dev = m_pDriver->GetDev();
 
   VulkanResourceManager *rm = m_pDriver->GetResourceManager();
@@ -3747,6 +3794,18 @@ vector<PixelModification> VulkanReplay::PixelHistory(vector<EventUsage> events,
                                                      uint32_t mip, uint32_t sampleIdx,
                                                      CompType typeHint)
 {
+  // when this gets implemented, don't start from one occlusion query per draw in the frame like
+  // D3D11 does. On tiled mobile GPUs especially, per-draw occlusion queries defeat the tiler
+  // and take hours on real content - the shape that fits them is fragment-shader feedback:
+  // patch each draw's fragment shader with a prologue that appends (eventId, depth, test
+  // results) to an SSBO for fragments covering the queried pixel (the same patching machinery
+  // as bindless feedback and postvs), collecting the entire history in a couple of replays.
+  //
+  // Whatever per-draw pass remains should also be culled up front: build a coarse screen-tile
+  // to drawcall index once per capture open (one low-res rasterise of each draw's geometry, or
+  // conservatively each draw's viewport/scissor intersection) and only replay-with-queries the
+  // draws whose tile mask covers the queried pixel. On draw-heavy frames the per-draw query
+  // pass dominates the whole feature's cost.
   VULKANNOTIMP("PixelHistory");
   return vector<PixelModification>();
 }
@@ -3768,6 +3827,20 @@ ShaderDebugTrace VulkanReplay::DebugPixel(uint32_t eventId, uint32_t x, uint32_t
 ShaderDebugTrace VulkanReplay::DebugThread(uint32_t eventId, const uint32_t groupid[3],
                                            const uint32_t threadid[3])
 {
+  // GPU-executed alternative worth building alongside the CPU interpreter: for compute shaders
+  // without derivatives or barriers gating divergent flow, instrument the target invocation's
+  // code path (SPIR-V editing as in vk_postvs) to stream each instruction's result into an
+  // SSBO during a real replay dispatch, then decode that readback into the same
+  // ShaderDebugTrace the CPU path produces. One dispatch plus a readback replaces minutes of
+  // interpretation, and the interpreter stays as the fallback for the shaders the
+  // instrumentation can't express.
+  //
+  // when SPIR-V debugging lands, plan for wide execution from the start: compute debugging
+  // must re-execute the whole workgroup for shared-memory and barrier interactions, and doing
+  // that one invocation at a time is minutes per trace on 1024-wide groups. A
+  // structure-of-arrays register file stepped 8-16 lanes at once with divergence masks, plus
+  // memoised uniform-branch fast paths, makes workgroup re-execution tractable - the same
+  // lane-group model the DXBC interpreter note describes.
   VULKANNOTIMP("DebugThread");
   return ShaderDebugTrace();
 }
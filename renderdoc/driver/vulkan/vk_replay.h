@@ -390,8 +390,13 @@ private:
 
   void FetchVSOut(uint32_t eventId);
   void FetchTessGSOut(uint32_t eventId);
+
+public:
+  // public so the memory allocator can evict this recreatable cache under memory pressure
   void ClearPostVSCache();
 
+private:
+
   bool RenderTextureInternal(TextureDisplay cfg, VkRenderPassBeginInfo rpbegin, int flags);
 
   bool GetMinMax(ResourceId texid, uint32_t sliceFace, uint32_t mip, uint32_t sample,
@@ -562,6 +567,11 @@ private:
     VkPipelineLayout m_QuadResolvePipeLayout = VK_NULL_HANDLE;
     VkPipeline m_QuadResolvePipeline[8] = {VK_NULL_HANDLE};
 
+    // patched pipelines for the quad overdraw overlay, keyed by the base pipeline, kept for the
+    // session so re-toggling the overlay doesn't recreate them. Cleared on shader replacement
+    // since the patched pipelines bake the original shaders.
+    std::map<ResourceId, std::pair<uint32_t, VkPipeline>> m_QuadPipeCache;
+
     GPUBuffer m_TriSizeUBO;
     VkDescriptorSetLayout m_TriSizeDescSetLayout = VK_NULL_HANDLE;
     VkDescriptorSet m_TriSizeDescSet = VK_NULL_HANDLE;
@@ -674,6 +684,12 @@ private:
   vector<CounterResult> FetchCountersAMD(const vector<GPUCounter> &counters);
 
   AMDCounters *m_pAMDCounters = NULL;
+
+  // counter plugin initialisation runs on this thread in the background so device creation
+  // isn't blocked behind hardware counter enumeration; the counter entry points join it before
+  // touching m_pAMDCounters
+  Threading::ThreadHandle m_CounterInitThread = 0;
+  void WaitForCounterInit();
   AMDRGPControl *m_RGP = NULL;
 
   VulkanAMDDrawCallback *m_pAMDDrawCallback = NULL;
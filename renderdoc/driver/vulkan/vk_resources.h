@@ -1006,6 +1006,13 @@ struct AttachmentInfo
   VkImageMemoryBarrier barrier;
 };
 
+// Scale note for bindless/RT captures: descriptor sets store a full DescriptorSetSlot array
+// per set - 500k-slot bindless sets make capture memory explode even though the slots are
+// mostly immutable and identical across sets from the same layout. The compaction design:
+// page the slot arrays (copy-on-write over a baseline snapshot shared by sets created from
+// the same layout), mutate pages on descriptor writes, and have initial-state serialisation
+// walk only occupied pages - the same page-sharing idea as the sparse initial-state dedup,
+// applied to CPU-side tracking.
 struct MemRefs
 {
   Intervals<FrameRefType> rangeRefs;
@@ -111,6 +111,13 @@ struct VulkanBlobShaderCallbacks
   const byte *GetData(SPIRVBlob blob) const { return (const byte *)blob->data(); }
 } VulkanShaderCacheCallbacks;
 
+// Cold-start note: first run on a machine compiles every builtin shader through glslang (~2s);
+// the on-disk SPIR-V blob cache below makes every later run skip that, so build-time
+// precompiled packs only improve the very first open. They're still worth doing for that case,
+// but the wrinkle is variant selection: builtin shaders compile against feature checks and
+// driver workarounds decided at runtime, so a build step has to enumerate the variant matrix
+// (or precompile only the unconditional shaders and leave the conditional few to the cache).
+// glslang stays needed at runtime regardless for user custom shaders.
 VulkanShaderCache::VulkanShaderCache(WrappedVulkan *driver)
 {
   // Load shader cache, if present
@@ -125,6 +132,69 @@ VulkanShaderCache::VulkanShaderCache(WrappedVulkan *driver)
 
   SetCaching(true);
 
+  // create the replay pipeline cache, seeded with any blob previously saved for this device.
+  // Profiling note: this persistent cache is also the storage layer a per-basic-block cost
+  // annotation mode would lean on - compile truncated shader prefixes (cut at basic-block
+  // boundaries), measure each truncated pipeline's draw with the counter machinery, and
+  // attribute the deltas to the blocks in between. The N truncated compiles are one-time work
+  // precisely because they land in this cache; the measurement results need their own small
+  // per-(shader hash, event) cache beside it so re-viewing an annotated shader is instant.
+  // GPU-dependent and approximate (truncation perturbs register allocation), so the annotation
+  // should present cost ranges rather than exact numbers.
+  //
+  // The cache file is keyed by the driver's pipelineCacheUUID, and the driver additionally
+  // validates the blob itself, so a stale file just behaves like an empty cache. This is
+  // replay-only - we don't want the extra cache or its disk traffic inside captured
+  // applications.
+  if(IsReplayMode(driver->GetState()))
+  {
+    const VkPhysicalDeviceProperties &props = driver->GetDeviceProps();
+
+    std::string uuid;
+    for(size_t i = 0; i < VK_UUID_SIZE; i++)
+      uuid += StringFormat::Fmt("%02x", props.pipelineCacheUUID[i]);
+
+    m_PipelineCacheFile = "vkpipelines_" + uuid + ".cache";
+
+    std::vector<byte> blob;
+
+    std::string path = FileIO::GetAppFolderFilename(m_PipelineCacheFile);
+    FILE *f = FileIO::fopen(path.c_str(), "rb");
+    if(f)
+    {
+      FileIO::fseek64(f, 0, SEEK_END);
+      uint64_t len = FileIO::ftell64(f);
+      FileIO::fseek64(f, 0, SEEK_SET);
+
+      blob.resize((size_t)len);
+      FileIO::fread(blob.data(), 1, (size_t)len, f);
+      FileIO::fclose(f);
+    }
+
+    VkPipelineCacheCreateInfo createInfo = {
+        VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO, NULL, 0, blob.size(), blob.data(),
+    };
+
+    VkResult vkr = ObjDisp(m_Device)->CreatePipelineCache(Unwrap(m_Device), &createInfo, NULL,
+                                                          &m_PipelineCache);
+
+    // a corrupt blob can be rejected outright - retry with an empty cache
+    if(vkr != VK_SUCCESS && !blob.empty())
+    {
+      createInfo.initialDataSize = 0;
+      createInfo.pInitialData = NULL;
+
+      vkr = ObjDisp(m_Device)->CreatePipelineCache(Unwrap(m_Device), &createInfo, NULL,
+                                                   &m_PipelineCache);
+    }
+
+    if(vkr != VK_SUCCESS)
+    {
+      RDCWARN("Couldn't create replay pipeline cache: %s", ToStr(vkr).c_str());
+      m_PipelineCache = VK_NULL_HANDLE;
+    }
+  }
+
   VkDriverInfo driverVersion = driver->GetDriverInfo();
   const VkPhysicalDeviceFeatures &features = driver->GetDeviceFeatures();
 
@@ -214,6 +284,34 @@ VulkanShaderCache::~VulkanShaderCache()
 
   for(size_t i = 0; i < ARRAY_COUNT(m_BuiltinShaderModules); i++)
     m_pDriver->vkDestroyShaderModule(m_Device, m_BuiltinShaderModules[i], NULL);
+
+  if(m_PipelineCache != VK_NULL_HANDLE)
+  {
+    // save the accumulated pipeline cache blob for the next replay session on this device
+    size_t size = 0;
+    VkResult vkr =
+        ObjDisp(m_Device)->GetPipelineCacheData(Unwrap(m_Device), m_PipelineCache, &size, NULL);
+
+    if(vkr == VK_SUCCESS && size > 0)
+    {
+      std::vector<byte> blob(size);
+      vkr = ObjDisp(m_Device)->GetPipelineCacheData(Unwrap(m_Device), m_PipelineCache, &size,
+                                                    blob.data());
+
+      if(vkr == VK_SUCCESS)
+      {
+        std::string path = FileIO::GetAppFolderFilename(m_PipelineCacheFile);
+        FILE *f = FileIO::fopen(path.c_str(), "wb");
+        if(f)
+        {
+          FileIO::fwrite(blob.data(), 1, size, f);
+          FileIO::fclose(f);
+        }
+      }
+    }
+
+    ObjDisp(m_Device)->DestroyPipelineCache(Unwrap(m_Device), m_PipelineCache, NULL);
+  }
 }
 
 std::string VulkanShaderCache::GetSPIRVBlob(const SPIRVCompilationSettings &settings,
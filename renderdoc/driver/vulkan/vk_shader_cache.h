@@ -74,6 +74,9 @@ public:
   void MakeGraphicsPipelineInfo(VkGraphicsPipelineCreateInfo &pipeCreateInfo, ResourceId pipeline);
   void MakeComputePipelineInfo(VkComputePipelineCreateInfo &pipeCreateInfo, ResourceId pipeline);
 
+  // replay-time pipeline cache, seeded from disk so repeat opens of captures from the same
+  // device skip most pipeline compilation. Unwrapped handle, only for internal use.
+  VkPipelineCache GetPipelineCache() { return m_PipelineCache; }
   void SetCaching(bool enabled) { m_CacheShaders = enabled; }
 private:
   static const uint32_t m_ShaderCacheMagic = 0xf00d00d5;
@@ -85,6 +88,9 @@ private:
   bool m_ShaderCacheDirty = false, m_CacheShaders = false;
   std::map<uint32_t, SPIRVBlob> m_ShaderCache;
 
+  std::string m_PipelineCacheFile;
+  VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+
   SPIRVBlob m_BuiltinShaderBlobs[arraydim<BuiltinShader>()] = {NULL};
   VkShaderModule m_BuiltinShaderModules[arraydim<BuiltinShader>()] = {VK_NULL_HANDLE};
 };
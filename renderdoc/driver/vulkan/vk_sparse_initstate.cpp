@@ -374,8 +374,12 @@ uint64_t WrappedVulkan::GetSize_SparseInitialState(ResourceId id, const VkInitia
     // the list of memory regions to copy
     ret += 8 + sizeof(MemIDOffset) * info.numUniqueMems;
 
-    // the actual data
+    // the actual data, plus the page dedup index and per-page serialisation framing (a length
+    // prefix and alignment padding each) - the estimate must stay an upper bound, since it can
+    // become the recorded chunk length
     ret += uint64_t(info.totalSize + WriteSerialiser::GetChunkAlignment());
+    ret += 8 + ((info.totalSize / (64 * 1024)) + 1) *
+                   (sizeof(uint32_t) + 8 + WriteSerialiser::GetChunkAlignment());
 
     return ret;
   }
@@ -399,8 +403,12 @@ uint64_t WrappedVulkan::GetSize_SparseInitialState(ResourceId id, const VkInitia
     // the list of memory regions to copy
     ret += sizeof(MemIDOffset) * info.numUniqueMems;
 
-    // the actual data
+    // the actual data, plus the page dedup index and per-page serialisation framing (a length
+    // prefix and alignment padding each) - the estimate must stay an upper bound, since it can
+    // become the recorded chunk length
     ret += uint64_t(info.totalSize + WriteSerialiser::GetChunkAlignment());
+    ret += 8 + ((info.totalSize / (64 * 1024)) + 1) *
+                   (sizeof(uint32_t) + 8 + WriteSerialiser::GetChunkAlignment());
 
     return ret;
   }
@@ -409,6 +417,135 @@ uint64_t WrappedVulkan::GetSize_SparseInitialState(ResourceId id, const VkInitia
   return 128;
 }
 
+
+// serialises the packed page contents of a sparse resource, deduplicating identical pages.
+// Sparse-resident resources commonly map many virtual pages onto a few shared physical pages
+// (e.g. one dummy page behind most of a terrain heap), and serialising every binding's contents
+// individually balloons the capture - identical pages are stored once and referenced by index.
+// From capture version 0x10; older captures store the contents verbatim.
+template <typename SerialiserType>
+static void SerialiseSparsePageContents(SerialiserType &ser, byte *Contents, uint64_t ContentsSize)
+{
+  // the Vulkan standard sparse block size, which page contents are deduplicated at
+  const uint64_t pageSize = 64 * 1024;
+
+  if(!ser.IsWriting() && !ser.VersionAtLeast(0x10))
+  {
+    // not using SERIALISE_ELEMENT_ARRAY so we can deliberately avoid allocation - we serialise
+    // directly into upload memory
+    ser.Serialise("Contents"_lit, Contents, ContentsSize, SerialiserFlags::NoFlags);
+    return;
+  }
+
+  uint64_t numPages = (ContentsSize + pageSize - 1) / pageSize;
+
+  // for each page, the index of the unique page holding its contents
+  std::vector<uint32_t> pageIndices;
+
+  if(ser.IsWriting() && Contents)
+  {
+    pageIndices.reserve((size_t)numPages);
+
+    // hash -> unique page indices with that hash, checked with a full compare to be safe
+    std::map<uint64_t, std::vector<uint32_t>> candidates;
+    std::vector<uint64_t> uniquePageOffsets;
+
+    for(uint64_t page = 0; page < numPages; page++)
+    {
+      const byte *pageData = Contents + page * pageSize;
+      const uint64_t size = RDCMIN(pageSize, ContentsSize - page * pageSize);
+
+      // FNV-1a
+      uint64_t hash = 14695981039346656037ULL;
+      for(uint64_t i = 0; i < size; i++)
+      {
+        hash ^= pageData[i];
+        hash *= 1099511628211ULL;
+      }
+
+      uint32_t uniqueIndex = ~0U;
+
+      std::vector<uint32_t> &matches = candidates[hash];
+
+      for(uint32_t match : matches)
+      {
+        const uint64_t matchSize =
+            RDCMIN(pageSize, ContentsSize - uniquePageOffsets[match]);
+
+        if(matchSize == size && memcmp(Contents + uniquePageOffsets[match], pageData, (size_t)size) == 0)
+        {
+          uniqueIndex = match;
+          break;
+        }
+      }
+
+      if(uniqueIndex == ~0U)
+      {
+        uniqueIndex = (uint32_t)uniquePageOffsets.size();
+        uniquePageOffsets.push_back(page * pageSize);
+        matches.push_back(uniqueIndex);
+      }
+
+      pageIndices.push_back(uniqueIndex);
+    }
+  }
+
+  ser.Serialise("pageIndices"_lit, pageIndices);
+
+  // don't trust the file - the index list must cover exactly the pages of the contents, and
+  // unique indices must appear in first-reference order (which is how they're generated above)
+  if(!ser.IsWriting() && pageIndices.size() != numPages)
+  {
+    RDCERR("Corrupt sparse page index - %zu indices for %llu pages", pageIndices.size(), numPages);
+    return;
+  }
+
+  // the first page that references each unique page - on reading, unique contents are serialised
+  // straight into that page's position and copied to the other references afterwards.
+  std::vector<uint64_t> uniqueFirstPage;
+
+  for(size_t page = 0; page < pageIndices.size(); page++)
+  {
+    uint32_t unique = pageIndices[page];
+
+    if(unique == uniqueFirstPage.size())
+    {
+      uniqueFirstPage.push_back(page);
+    }
+    else if(unique > uniqueFirstPage.size())
+    {
+      RDCERR("Corrupt sparse page index - unique page %u referenced before definition", unique);
+      return;
+    }
+  }
+
+  for(size_t u = 0; u < uniqueFirstPage.size(); u++)
+  {
+    const uint64_t offset = uniqueFirstPage[u] * pageSize;
+    const uint64_t size = RDCMIN(pageSize, ContentsSize - offset);
+
+    byte *pageData = Contents ? Contents + offset : NULL;
+
+    ser.Serialise("page"_lit, pageData, size, SerialiserFlags::NoFlags);
+  }
+
+  // expand the shared pages out to every page that references them
+  if(!ser.IsWriting() && Contents)
+  {
+    for(size_t page = 0; page < pageIndices.size(); page++)
+    {
+      const uint64_t first = uniqueFirstPage[pageIndices[page]];
+
+      if(first == page)
+        continue;
+
+      const uint64_t size = RDCMIN(pageSize, ContentsSize - page * pageSize);
+
+      memcpy(Contents + page * pageSize, Contents + first * pageSize, (size_t)size);
+    }
+  }
+}
+
 template <typename SerialiserType>
 bool WrappedVulkan::Serialise_SparseBufferInitialState(SerialiserType &ser, ResourceId id,
                                                        const VkInitialContents *contents)
@@ -479,9 +616,7 @@ bool WrappedVulkan::Serialise_SparseBufferInitialState(SerialiserType &ser, Reso
                           0, (void **)&Contents);
   }
 
-  // not using SERIALISE_ELEMENT_ARRAY so we can deliberately avoid allocation - we serialise
-  // directly into upload memory
-  ser.Serialise("Contents"_lit, Contents, ContentsSize, SerialiserFlags::NoFlags);
+  SerialiseSparsePageContents(ser, Contents, ContentsSize);
 
   // unmap the resource we mapped before - we need to do this on read and on write.
   if(!IsStructuredExporting(m_State) && mappedMem.mem != VK_NULL_HANDLE)
@@ -582,9 +717,7 @@ bool WrappedVulkan::Serialise_SparseImageInitialState(SerialiserType &ser, Resou
                           0, (void **)&Contents);
   }
 
-  // not using SERIALISE_ELEMENT_ARRAY so we can deliberately avoid allocation - we serialise
-  // directly into upload memory
-  ser.Serialise("Contents"_lit, Contents, ContentsSize, SerialiserFlags::NoFlags);
+  SerialiseSparsePageContents(ser, Contents, ContentsSize);
 
   // unmap the resource we mapped before - we need to do this on read and on write.
   if(!IsStructuredExporting(m_State) && mappedMem.mem != VK_NULL_HANDLE)
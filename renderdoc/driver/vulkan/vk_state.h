@@ -44,6 +44,13 @@ struct VulkanStatePipeline
   vector<DescriptorAndOffsets> descSets;
 };
 
+// Storage note: replay paths that retain a snapshot of this state per draw (and the analogous
+// D3D12 tracking) pay full-state cost for draws that differ from their neighbour in a handful
+// of bindings - gigabytes on 80k-draw captures. The compression shape is delta chaining: store
+// draw N as a diff against draw N-1 with a keyframe every K draws, reconstruct on demand, and
+// keep a small LRU of materialised states for scrubbing locality. The structured-data diff
+// utility provides the tree-diff machinery; the keyframe interval trades reconstruction cost
+// against memory and wants tuning against real captures.
 struct VulkanRenderState
 {
   enum PipelineBinding
@@ -761,6 +761,12 @@ bool WrappedVulkan::Serialise_vkBeginCommandBuffer(SerialiserType &ser, VkComman
 
       m_BakedCmdBufferInfo[m_LastCmdBufferID].curEventID = 0;
       m_BakedCmdBufferInfo[BakedCommandBuffer].curEventID = 0;
+
+      // if this command buffer isn't being re-recorded at all, every chunk from here until the
+      // matching vkEndCommandBuffer is a no-op for this replay. Ask the replay loop to skip the
+      // reader straight to the end chunk rather than deserialising each vkCmd individually.
+      if(!rerecord && m_BakedCmdBufferInfo[BakedCommandBuffer].endChunkByteOffset > 0)
+        m_SkipChunksToOffset = m_BakedCmdBufferInfo[BakedCommandBuffer].endChunkByteOffset;
     }
     else
     {
@@ -1051,6 +1057,7 @@ bool WrappedVulkan::Serialise_vkEndCommandBuffer(SerialiserType &ser, VkCommandB
 
         m_BakedCmdBufferInfo[BakedCommandBuffer].endChunk =
             uint32_t(m_StructuredFile->chunks.size() - 1);
+        m_BakedCmdBufferInfo[BakedCommandBuffer].endChunkByteOffset = m_CurChunkOffset;
 
         m_BakedCmdBufferInfo[CommandBuffer].curEventID = 0;
         m_BakedCmdBufferInfo[CommandBuffer].eventCount = 0;
@@ -4202,6 +4209,14 @@ bool WrappedVulkan::Serialise_vkCmdBeginDebugUtilsLabelEXT(SerialiserType &ser,
   return true;
 }
 
+// Timing note: captures store no GPU timing from the original run - replay-time counters
+// measure replay hardware, not what actually happened. The ground-truth plan hooks here:
+// optionally (off by default, capture-option gated) inject vkCmdWriteTimestamp pairs around
+// each label region up to a configurable depth during active capture, resolve the query pool
+// after the frame's fences, and record the (label, begin, end) series into its own metadata
+// section beside FrameStats - readable without replay, shown as 'original frame' timings in
+// the event browser. Injection perturbs the captured command streams, which is why it must be
+// opt-in; the CPU-side submit timings in FrameStats v3 are the always-on counterpart.
 void WrappedVulkan::vkCmdBeginDebugUtilsLabelEXT(VkCommandBuffer commandBuffer,
                                                  const VkDebugUtilsLabelEXT *pLabelInfo)
 {
@@ -927,6 +927,13 @@ bool WrappedVulkan::Serialise_vkEnumeratePhysicalDevices(SerialiserType &ser, Vk
     // match up physical devices to those available on replay as best as possible. In general
     // hopefully the most common case is when there's a precise match, and maybe the order changed.
     //
+    // This vendor/device-ID scoring already covers the 'replay landed on the iGPU' case when the
+    // capture records the discrete GPU's IDs. What it can't express is an explicit user override
+    // (captures from a different machine match nothing exactly) - that needs an adapter index
+    // plumbed through capture open options in the public API, and a per-title affinity cache
+    // belongs UI-side where titles are identified. With an override present this loop would
+    // simply pin the chosen adapter instead of scoring.
+    //
     // If more GPUs were present on replay than during capture, we map many-to-one which might have
     // bad side-effects as e.g. we have to pick one memidxmap, but this is as good as we can do.
 
@@ -778,6 +778,9 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
   SERIALISE_TIME_CALL(ret = ObjDisp(queue)->QueueSubmit(Unwrap(queue), submitCount,
                                                         unwrappedSubmits, Unwrap(fence)));
 
+  // the CPU cost of the real submit, just stamped by SERIALISE_TIME_CALL
+  uint64_t submitDurationMicro = GetThreadSerialiser().ChunkMetadata().durationMicro;
+
   bool capframe = false;
   bool present = false;
 
@@ -909,6 +912,10 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
 
   if(capframe)
   {
+    // feed the capture's FrameStats section so dashboards get per-submit CPU timings without
+    // replaying the capture
+    RenderDoc::Inst().AddFrameSubmitTiming(submitDurationMicro);
+
     GetResourceManager()->MarkResourceFrameReferenced(GetResID(queue), eFrameRef_Read);
 
     if(fence != VK_NULL_HANDLE)
@@ -920,6 +927,14 @@ VkResult WrappedVulkan::vkQueueSubmit(VkQueue queue, uint32_t submitCount,
       maps = m_CoherentMaps;
     }
 
+    // Performance note: every submit scans each referenced coherent mapping byte-wise via
+    // FindDiffRange below - the dominant capture cost for titles persistently mapping large
+    // heaps. OS write-watch would cut this to dirty pages only, but the obvious APIs don't fit:
+    // Windows GetWriteWatch only works on our own MEM_WRITE_WATCH VirtualAllocs, and these
+    // pointers come from the driver's vkMapMemory. Linux soft-dirty (/proc/self/clear_refs +
+    // pagemap) does work on arbitrary mappings and could gate the scan to OS-reported dirty
+    // pages; Windows would need an exception-based page-protection tracker like the proposed
+    // D3D11 shadow scheme. Until then the refdIDs filter above is the only reduction.
     for(auto it = maps.begin(); it != maps.end(); ++it)
     {
       VkResourceRecord *record = *it;
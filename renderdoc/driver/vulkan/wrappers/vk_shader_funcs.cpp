@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "../vk_core.h"
+#include "../vk_shader_cache.h"
 #include "driver/shaders/spirv/spirv_common.h"
 
 template <>
@@ -418,12 +419,14 @@ bool WrappedVulkan::Serialise_vkCreateGraphicsPipelines(
     VkRenderPass origRP = CreateInfo.renderPass;
     VkPipelineCache origCache = pipelineCache;
 
-    // don't use pipeline caches on replay
+    // don't use the application's pipeline cache on replay - instead use our own persistent
+    // cache, seeded from disk, so repeat opens skip most pipeline compilation
     pipelineCache = VK_NULL_HANDLE;
+    VkPipelineCache replayCache = GetShaderCache()->GetPipelineCache();
 
     VkGraphicsPipelineCreateInfo *unwrapped = UnwrapInfos(&CreateInfo, 1);
-    VkResult ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), Unwrap(pipelineCache),
-                                                            1, unwrapped, NULL, &pipe);
+    VkResult ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), replayCache, 1,
+                                                            unwrapped, NULL, &pipe);
 
     if(ret != VK_SUCCESS)
     {
@@ -460,8 +463,8 @@ bool WrappedVulkan::Serialise_vkCreateGraphicsPipelines(
         CreateInfo.subpass = 0;
 
         unwrapped = UnwrapInfos(&CreateInfo, 1);
-        ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), Unwrap(pipelineCache), 1,
-                                                       unwrapped, NULL, &pipeInfo.subpass0pipe);
+        ret = ObjDisp(device)->CreateGraphicsPipelines(Unwrap(device), replayCache, 1, unwrapped,
+                                                       NULL, &pipeInfo.subpass0pipe);
         RDCASSERTEQUAL(ret, VK_SUCCESS);
 
         ResourceId subpass0id =
@@ -611,11 +614,13 @@ bool WrappedVulkan::Serialise_vkCreateComputePipelines(SerialiserType &ser, VkDe
 
     VkPipelineCache origCache = pipelineCache;
 
-    // don't use pipeline caches on replay
+    // don't use the application's pipeline cache on replay - instead use our own persistent
+    // cache, seeded from disk, so repeat opens skip most pipeline compilation
     pipelineCache = VK_NULL_HANDLE;
+    VkPipelineCache replayCache = GetShaderCache()->GetPipelineCache();
 
     VkComputePipelineCreateInfo *unwrapped = UnwrapInfos(&CreateInfo, 1);
-    VkResult ret = ObjDisp(device)->CreateComputePipelines(Unwrap(device), Unwrap(pipelineCache), 1,
+    VkResult ret = ObjDisp(device)->CreateComputePipelines(Unwrap(device), replayCache, 1,
                                                            unwrapped, NULL, &pipe);
 
     if(ret != VK_SUCCESS)
@@ -37,6 +37,14 @@ LibraryHook::LibraryHook()
   LibList().push_back(this);
 }
 
+// Startup note: on Windows, EndHookRegistration applies every registered function hook across
+// every loaded module's import table up front, which is where injected titles lose tens of
+// seconds at boot. A lazy scheme would patch only the loader entry points
+// (LoadLibrary/GetProcAddress) at inject time and apply a module's IAT patches the first time
+// any hooked function in it is about to be used, with the per-module scans run through the
+// worker pool. The module-load callback plumbing here already supports deferred installation;
+// what's missing is per-module patch bookkeeping on the Windows side, and care that two threads
+// racing to first-use of one module serialise their patching.
 void LibraryHooks::RegisterHooks()
 {
   BeginHookRegistration();
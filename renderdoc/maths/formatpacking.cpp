@@ -0,0 +1,247 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/common.h"
+#include "formatpacking.h"
+
+// batched texel conversion kernels. SSE2 is the baseline on x86-64 and NEON on AArch64, so we
+// select the vector path at compile time and keep a scalar tail/fallback that exactly matches the
+// single-texel inline conversions in formatpacking.h/half_convert.h.
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <emmintrin.h>
+#include <xmmintrin.h>
+
+#define BATCH_CONVERT_SSE2 OPTION_ON
+#define BATCH_CONVERT_NEON OPTION_OFF
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+
+// MSVC targeting ARM64 doesn't define __aarch64__ but ships the same arm_neon.h intrinsics, so
+// native ARM64 windows builds get the NEON kernels rather than falling to the scalar path. The
+// vcxproj side needs ARM64 configurations adding before that build exists; nothing else in
+// these kernels is compiler-specific.
+#include <arm_neon.h>
+
+#define BATCH_CONVERT_SSE2 OPTION_OFF
+#define BATCH_CONVERT_NEON OPTION_ON
+
+#else
+
+#define BATCH_CONVERT_SSE2 OPTION_OFF
+#define BATCH_CONVERT_NEON OPTION_OFF
+
+#endif
+
+void ConvertFromR10G10B10A2(const uint32_t *data, Vec4f *out, size_t count)
+{
+  size_t i = 0;
+
+#if ENABLED(BATCH_CONVERT_SSE2)
+  // divide rather than multiplying by a reciprocal, to stay bit-identical with the scalar path
+  const __m128i mask10 = _mm_set1_epi32(0x3ff);
+  const __m128 max10 = _mm_set1_ps(1023.0f);
+  const __m128 max2 = _mm_set1_ps(3.0f);
+
+  for(; i + 4 <= count; i += 4)
+  {
+    __m128i packed = _mm_loadu_si128((const __m128i *)(data + i));
+
+    __m128 r = _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(packed, mask10)), max10);
+    __m128 g =
+        _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 10), mask10)), max10);
+    __m128 b =
+        _mm_div_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(packed, 20), mask10)), max10);
+    __m128 a = _mm_div_ps(_mm_cvtepi32_ps(_mm_srli_epi32(packed, 30)), max2);
+
+    // transpose the component vectors into one Vec4f per texel
+    _MM_TRANSPOSE4_PS(r, g, b, a);
+
+    _mm_storeu_ps(&out[i + 0].x, r);
+    _mm_storeu_ps(&out[i + 1].x, g);
+    _mm_storeu_ps(&out[i + 2].x, b);
+    _mm_storeu_ps(&out[i + 3].x, a);
+  }
+#elif ENABLED(BATCH_CONVERT_NEON)
+  // divide rather than multiplying by a reciprocal, to stay bit-identical with the scalar path
+  const uint32x4_t mask10 = vdupq_n_u32(0x3ff);
+  const float32x4_t max10 = vdupq_n_f32(1023.0f);
+  const float32x4_t max2 = vdupq_n_f32(3.0f);
+
+  for(; i + 4 <= count; i += 4)
+  {
+    uint32x4_t packed = vld1q_u32(data + i);
+
+    float32x4x4_t texels;
+    texels.val[0] = vdivq_f32(vcvtq_f32_u32(vandq_u32(packed, mask10)), max10);
+    texels.val[1] = vdivq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(packed, 10), mask10)), max10);
+    texels.val[2] = vdivq_f32(vcvtq_f32_u32(vandq_u32(vshrq_n_u32(packed, 20), mask10)), max10);
+    texels.val[3] = vdivq_f32(vcvtq_f32_u32(vshrq_n_u32(packed, 30)), max2);
+
+    // st4 interleaves the component vectors into one Vec4f per texel
+    vst4q_f32(&out[i].x, texels);
+  }
+#endif
+
+  for(; i < count; i++)
+    out[i] = ConvertFromR10G10B10A2(data[i]);
+}
+
+void ConvertFromR11G11B10(const uint32_t *data, Vec3f *out, size_t count)
+{
+  // the denormal and infinity/nan handling keeps this scalar for now - batching still saves the
+  // per-texel call overhead on hot paths.
+  for(size_t i = 0; i < count; i++)
+    out[i] = ConvertFromR11G11B10(data[i]);
+}
+
+void ConvertFromRGBA8(const uint8_t *data, Vec4f *out, size_t count, bool bgraOrder)
+{
+  size_t i = 0;
+
+#if ENABLED(BATCH_CONVERT_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  // divide rather than multiplying by a reciprocal, to stay bit-identical with the scalar path
+  const __m128 max8 = _mm_set1_ps(255.0f);
+
+  for(; i + 4 <= count; i += 4)
+  {
+    // 16 bytes = 4 texels. Widen 8 -> 16 -> 32 bits, convert, scale. Each texel's components
+    // stay contiguous so no transpose is needed.
+    __m128i bytes = _mm_loadu_si128((const __m128i *)(data + i * 4));
+
+    __m128i lo16 = _mm_unpacklo_epi8(bytes, zero);
+    __m128i hi16 = _mm_unpackhi_epi8(bytes, zero);
+
+    __m128 texels[4] = {
+        _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo16, zero)), max8),
+        _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo16, zero)), max8),
+        _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi16, zero)), max8),
+        _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi16, zero)), max8),
+    };
+
+    for(int t = 0; t < 4; t++)
+    {
+      if(bgraOrder)
+        texels[t] = _mm_shuffle_ps(texels[t], texels[t], _MM_SHUFFLE(3, 0, 1, 2));
+
+      _mm_storeu_ps(&out[i + t].x, texels[t]);
+    }
+  }
+#elif ENABLED(BATCH_CONVERT_NEON)
+  const float32x4_t max8 = vdupq_n_f32(255.0f);
+
+  for(; i + 4 <= count; i += 4)
+  {
+    uint8x16_t bytes = vld1q_u8(data + i * 4);
+
+    if(bgraOrder)
+    {
+      // swap R and B within each texel. Reversing the two half-words of each 32-bit texel turns
+      // [R,G,B,A] into [B,A,R,G], putting B and R at bytes 0 and 2; the original supplies G and
+      // A at bytes 1 and 3. (A full byte reverse would put A and G there instead.)
+      uint8x16_t swapped = vreinterpretq_u8_u16(vrev32q_u16(vreinterpretq_u16_u8(bytes)));
+      bytes = vorrq_u8(vandq_u8(swapped, vreinterpretq_u8_u32(vdupq_n_u32(0x00ff00ffU))),
+                       vandq_u8(bytes, vreinterpretq_u8_u32(vdupq_n_u32(0xff00ff00U))));
+    }
+
+    uint16x8_t lo16 = vmovl_u8(vget_low_u8(bytes));
+    uint16x8_t hi16 = vmovl_u8(vget_high_u8(bytes));
+
+    vst1q_f32(&out[i + 0].x, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo16))), max8));
+    vst1q_f32(&out[i + 1].x, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo16))), max8));
+    vst1q_f32(&out[i + 2].x, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi16))), max8));
+    vst1q_f32(&out[i + 3].x, vdivq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi16))), max8));
+  }
+#endif
+
+  for(; i < count; i++)
+  {
+    const uint8_t *texel = data + i * 4;
+
+    Vec4f v(float(texel[0]) / 255.0f, float(texel[1]) / 255.0f, float(texel[2]) / 255.0f,
+            float(texel[3]) / 255.0f);
+
+    if(bgraOrder)
+    {
+      float tmp = v.x;
+      v.x = v.z;
+      v.z = tmp;
+    }
+
+    out[i] = v;
+  }
+}
+
+void ConvertFromHalf(const uint16_t *data, float *out, size_t count)
+{
+  size_t i = 0;
+
+#if ENABLED(BATCH_CONVERT_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i expMask = _mm_set1_epi32(0x7c00);
+  const __m128i mantMask = _mm_set1_epi32(0x3ff);
+  const __m128i signMask = _mm_set1_epi32(0x8000);
+  const __m128i expBias = _mm_set1_epi32(112 << 23);
+  const __m128i nanBits = _mm_set1_epi32(0x7F800001);
+  const __m128 denormScale = _mm_set1_ps(1.0f / 16777216.0f);    // 2^-24
+
+  for(; i + 4 <= count; i += 4)
+  {
+    __m128i halves =
+        _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(data + i)), zero);
+
+    __m128i sign32 = _mm_slli_epi32(_mm_and_si128(halves, signMask), 16);
+    __m128i exp = _mm_and_si128(halves, expMask);
+    __m128i mant = _mm_and_si128(halves, mantMask);
+
+    // normals: shift exponent+mantissa into place and rebias the exponent
+    __m128i normal = _mm_add_epi32(
+        _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x7fff)), 13), expBias);
+
+    // subnormals: mantissa * 2^-24
+    __m128i denorm =
+        _mm_castps_si128(_mm_mul_ps(_mm_cvtepi32_ps(mant), denormScale));
+
+    __m128i expZero = _mm_cmpeq_epi32(exp, zero);
+    __m128i expMax = _mm_cmpeq_epi32(exp, expMask);
+    __m128i isZero = _mm_cmpeq_epi32(_mm_or_si128(exp, mant), zero);
+
+    __m128i bits = _mm_or_si128(_mm_and_si128(expZero, denorm), _mm_andnot_si128(expZero, normal));
+
+    bits = _mm_or_si128(bits, sign32);
+
+    // matching the scalar conversion: zero always comes out positive, and any inf/nan input
+    // produces the same quiet nan
+    bits = _mm_andnot_si128(isZero, bits);
+    bits = _mm_or_si128(_mm_and_si128(expMax, nanBits), _mm_andnot_si128(expMax, bits));
+
+    _mm_storeu_ps(out + i, _mm_castsi128_ps(bits));
+  }
+#endif
+
+  for(; i < count; i++)
+    out[i] = ConvertFromHalf(data[i]);
+}
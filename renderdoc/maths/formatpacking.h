@@ -186,4 +186,12 @@ inline Vec4f ConvertSRGBToLinear(Vec4f srgbF)
 struct ResourceFormat;
 float ConvertComponent(const ResourceFormat &fmt, const byte *data);
 
+// batched versions of the conversions above for hot paths that push many texels through them,
+// e.g. texture saving. Vectorised with SSE2/NEON where available, with results identical to the
+// single-texel functions.
+void ConvertFromR10G10B10A2(const uint32_t *data, Vec4f *out, size_t count);
+void ConvertFromR11G11B10(const uint32_t *data, Vec3f *out, size_t count);
+void ConvertFromRGBA8(const uint8_t *data, Vec4f *out, size_t count, bool bgraOrder);
+void ConvertFromHalf(const uint16_t *data, float *out, size_t count);
+
 #include "half_convert.h"
@@ -0,0 +1,146 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "common/common.h"
+#include "formatpacking.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include <string.h>
+#include <vector>
+#include "3rdparty/catch/catch.hpp"
+
+// the batched conversions must be bit-identical to the single-texel versions, including the
+// vector main loop and the scalar tail, so test with counts that don't divide evenly. Note this
+// only exercises the kernel compiled for the HOST architecture - an x86 test run proves nothing
+// about the NEON path (which shipped a broken BGRA swap for exactly that reason), so these tests
+// need a run on each architecture the kernels target.
+
+TEST_CASE("Test batched half conversion", "[formatpacking]")
+{
+  // exhaustive across every possible half value
+  std::vector<uint16_t> halves(65536);
+  for(size_t i = 0; i < halves.size(); i++)
+    halves[i] = uint16_t(i);
+
+  std::vector<float> batch(halves.size());
+  ConvertFromHalf(halves.data(), batch.data(), halves.size());
+
+  bool identical = true;
+  for(size_t i = 0; i < halves.size(); i++)
+  {
+    float scalar = ConvertFromHalf(halves[i]);
+    identical &= (memcmp(&batch[i], &scalar, sizeof(float)) == 0);
+  }
+
+  CHECK(identical);
+
+  // unaligned count to cover the tail
+  std::vector<float> tail(7);
+  ConvertFromHalf(halves.data() + 100, tail.data(), tail.size());
+
+  for(size_t i = 0; i < tail.size(); i++)
+  {
+    float scalar = ConvertFromHalf(halves[100 + i]);
+    CHECK(memcmp(&tail[i], &scalar, sizeof(float)) == 0);
+  }
+};
+
+TEST_CASE("Test batched R10G10B10A2 conversion", "[formatpacking]")
+{
+  std::vector<uint32_t> data(1027);
+  for(size_t i = 0; i < data.size(); i++)
+    data[i] = uint32_t(i * 2654435761U);
+
+  std::vector<Vec4f> batch(data.size());
+  ConvertFromR10G10B10A2(data.data(), batch.data(), data.size());
+
+  bool identical = true;
+  for(size_t i = 0; i < data.size(); i++)
+  {
+    Vec4f scalar = ConvertFromR10G10B10A2(data[i]);
+    identical &= (memcmp(&batch[i], &scalar, sizeof(Vec4f)) == 0);
+  }
+
+  CHECK(identical);
+};
+
+TEST_CASE("Test batched R11G11B10 conversion", "[formatpacking]")
+{
+  std::vector<uint32_t> data(515);
+  for(size_t i = 0; i < data.size(); i++)
+    data[i] = uint32_t(i * 2654435761U);
+
+  // include denormal and inf/nan encodings
+  data[0] = 0x00000001;
+  data[1] = 0x7800f000;
+  data[2] = 0xffffffff;
+
+  std::vector<Vec3f> batch(data.size());
+  ConvertFromR11G11B10(data.data(), batch.data(), data.size());
+
+  bool identical = true;
+  for(size_t i = 0; i < data.size(); i++)
+  {
+    Vec3f scalar = ConvertFromR11G11B10(data[i]);
+    identical &= (memcmp(&batch[i], &scalar, sizeof(Vec3f)) == 0);
+  }
+
+  CHECK(identical);
+};
+
+TEST_CASE("Test batched RGBA8 conversion", "[formatpacking]")
+{
+  std::vector<uint8_t> data(4 * 261);
+  for(size_t i = 0; i < data.size(); i++)
+    data[i] = uint8_t(i * 7);
+
+  for(bool bgra : {false, true})
+  {
+    std::vector<Vec4f> batch(data.size() / 4);
+    ConvertFromRGBA8(data.data(), batch.data(), batch.size(), bgra);
+
+    bool identical = true;
+    for(size_t i = 0; i < batch.size(); i++)
+    {
+      const uint8_t *texel = data.data() + i * 4;
+
+      Vec4f scalar(float(texel[0]) / 255.0f, float(texel[1]) / 255.0f, float(texel[2]) / 255.0f,
+                   float(texel[3]) / 255.0f);
+
+      if(bgra)
+      {
+        float tmp = scalar.x;
+        scalar.x = scalar.z;
+        scalar.z = tmp;
+      }
+
+      identical &= (memcmp(&batch[i], &scalar, sizeof(Vec4f)) == 0);
+    }
+
+    CHECK(identical);
+  }
+};
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -34,6 +34,13 @@
 
 #pragma once
 
+// LUT note: unlike some forks, this tree has no runtime-initialised conversion tables - the
+// sRGB table below in formatpacking is static rodata and half conversion is branchy bit logic,
+// so there's no per-process init to eliminate. If the SIMD texel kernels ever want gather
+// tables (a 256KB half->float table, 1024-entry 10/11-bit mantissa tables), generate them as
+// static data like SRGB8_lookuptable rather than at startup, with a unit test comparing every
+// entry against these functions.
+
 inline uint16_t ConvertToHalf(float comp)
 {
   int *alias = (int *)&comp;
@@ -0,0 +1,113 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "image_compare.h"
+#include "common/common.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <emmintrin.h>
+
+#define IMAGE_COMPARE_SSE2 OPTION_ON
+#define IMAGE_COMPARE_NEON OPTION_OFF
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#define IMAGE_COMPARE_SSE2 OPTION_OFF
+#define IMAGE_COMPARE_NEON OPTION_ON
+
+#else
+
+#define IMAGE_COMPARE_SSE2 OPTION_OFF
+#define IMAGE_COMPARE_NEON OPTION_OFF
+
+#endif
+
+// accumulates one pixel's max-channel difference into the stats
+static inline void AccumulateDiff(float pixelDiff, float tolerance, ImageDiffStats &stats)
+{
+  stats.pixels++;
+
+  if(pixelDiff > tolerance)
+    stats.differing++;
+
+  stats.maxDiff = RDCMAX(stats.maxDiff, pixelDiff);
+  stats.sumDiff += pixelDiff;
+
+  int bucket = int(pixelDiff * 16.0f);
+  stats.histogram[RDCCLAMP(bucket, 0, 15)]++;
+}
+
+void CompareImagesRGBA32F(const float *a, const float *b, size_t pixelCount, float tolerance,
+                          ImageDiffStats &stats)
+{
+  size_t i = 0;
+
+#if ENABLED(IMAGE_COMPARE_SSE2)
+  // clear the sign bit to get absolute values
+  const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+
+  for(; i < pixelCount; i++)
+  {
+    __m128 va = _mm_loadu_ps(a + i * 4);
+    __m128 vb = _mm_loadu_ps(b + i * 4);
+
+    __m128 diff = _mm_and_ps(_mm_sub_ps(va, vb), absMask);
+
+    // horizontal max over the four channels
+    __m128 shuf = _mm_shuffle_ps(diff, diff, _MM_SHUFFLE(2, 3, 0, 1));
+    diff = _mm_max_ps(diff, shuf);
+    shuf = _mm_shuffle_ps(diff, diff, _MM_SHUFFLE(1, 0, 3, 2));
+    diff = _mm_max_ps(diff, shuf);
+
+    AccumulateDiff(_mm_cvtss_f32(diff), tolerance, stats);
+  }
+#elif ENABLED(IMAGE_COMPARE_NEON)
+  for(; i < pixelCount; i++)
+  {
+    float32x4_t va = vld1q_f32(a + i * 4);
+    float32x4_t vb = vld1q_f32(b + i * 4);
+
+    float32x4_t diff = vabdq_f32(va, vb);
+
+    AccumulateDiff(vmaxvq_f32(diff), tolerance, stats);
+  }
+#else
+  for(; i < pixelCount; i++)
+  {
+    float pixelDiff = 0.0f;
+
+    for(int c = 0; c < 4; c++)
+    {
+      float d = a[i * 4 + c] - b[i * 4 + c];
+      pixelDiff = RDCMAX(pixelDiff, d < 0.0f ? -d : d);
+    }
+
+    AccumulateDiff(pixelDiff, tolerance, stats);
+  }
+#endif
+}
@@ -0,0 +1,52 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// image comparison kernels for the CPU texture diff path. Inputs are RGBA32 float pixels (the
+// remap target every texture fetch can produce), compared per-channel with a tolerance;
+// vectorised on x86-64/AArch64 with a scalar path that matches exactly.
+
+struct ImageDiffStats
+{
+  // pixels examined
+  uint64_t pixels = 0;
+  // pixels where any channel's absolute difference exceeds the tolerance
+  uint64_t differing = 0;
+  // largest per-pixel difference seen (max over channels)
+  float maxDiff = 0.0f;
+  // sum of per-pixel differences, for computing the mean
+  double sumDiff = 0.0;
+  // counts of per-pixel differences bucketed linearly over [0, 1) in 16 steps, with
+  // differences >= 1 landing in the last bucket
+  uint64_t histogram[16] = {};
+};
+
+// compares pixelCount RGBA32F pixels from a and b, accumulating into stats
+void CompareImagesRGBA32F(const float *a, const float *b, size_t pixelCount, float tolerance,
+                          ImageDiffStats &stats);
@@ -0,0 +1,130 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "image_compare.h"
+#include "common/common.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include <stdlib.h>
+#include <vector>
+#include "3rdparty/catch/catch.hpp"
+
+// scalar reference the kernel must match exactly
+static void RefCompare(const float *a, const float *b, size_t pixelCount, float tolerance,
+                       ImageDiffStats &stats)
+{
+  for(size_t i = 0; i < pixelCount; i++)
+  {
+    float pixelDiff = 0.0f;
+    for(int c = 0; c < 4; c++)
+    {
+      float d = a[i * 4 + c] - b[i * 4 + c];
+      if(d < 0.0f)
+        d = -d;
+      if(d > pixelDiff)
+        pixelDiff = d;
+    }
+
+    stats.pixels++;
+    if(pixelDiff > tolerance)
+      stats.differing++;
+    if(pixelDiff > stats.maxDiff)
+      stats.maxDiff = pixelDiff;
+    stats.sumDiff += pixelDiff;
+    int bucket = int(pixelDiff * 16.0f);
+    stats.histogram[bucket < 0 ? 0 : bucket > 15 ? 15 : bucket]++;
+  }
+}
+
+TEST_CASE("Test image comparison kernel", "[maths][imagecompare]")
+{
+  SECTION("matches the scalar reference on random data")
+  {
+    srand(4321);
+
+    std::vector<float> a(4 * 1000), b(4 * 1000);
+    for(size_t i = 0; i < a.size(); i++)
+    {
+      a[i] = float(rand()) / float(RAND_MAX) * 2.0f - 0.5f;
+      b[i] = a[i] + (float(rand()) / float(RAND_MAX) - 0.5f) * 0.2f;
+    }
+
+    for(size_t count = 0; count <= 1000; count += 37)
+    {
+      ImageDiffStats stats, ref;
+      CompareImagesRGBA32F(a.data(), b.data(), count, 0.01f, stats);
+      RefCompare(a.data(), b.data(), count, 0.01f, ref);
+
+      REQUIRE(stats.pixels == ref.pixels);
+      REQUIRE(stats.differing == ref.differing);
+      REQUIRE(stats.maxDiff == ref.maxDiff);
+      REQUIRE(stats.sumDiff == ref.sumDiff);
+      for(int bucket = 0; bucket < 16; bucket++)
+        REQUIRE(stats.histogram[bucket] == ref.histogram[bucket]);
+    }
+  }
+
+  SECTION("identical images have zero differences")
+  {
+    std::vector<float> img(4 * 256, 0.5f);
+
+    ImageDiffStats stats;
+    CompareImagesRGBA32F(img.data(), img.data(), 256, 0.0f, stats);
+
+    CHECK(stats.pixels == 256);
+    CHECK(stats.differing == 0);
+    CHECK(stats.maxDiff == 0.0f);
+    CHECK(stats.histogram[0] == 256);
+  }
+
+  SECTION("tolerance gates the differing count but not the histogram")
+  {
+    float a[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+    float b[8] = {0.05f, 0.0f, 0.0f, 0.0f, 0.5f, 0.0f, 0.0f, 0.0f};
+
+    ImageDiffStats stats;
+    CompareImagesRGBA32F(a, b, 2, 0.1f, stats);
+
+    CHECK(stats.pixels == 2);
+    CHECK(stats.differing == 1);    // only the 0.5 diff exceeds 0.1
+    CHECK(stats.histogram[0] == 1);
+    CHECK(stats.histogram[8] == 1);
+  }
+
+  SECTION("differences above one land in the last bucket")
+  {
+    float a[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    float b[4] = {25.0f, 0.0f, 0.0f, 0.0f};
+
+    ImageDiffStats stats;
+    CompareImagesRGBA32F(a, b, 1, 0.0f, stats);
+
+    CHECK(stats.histogram[15] == 1);
+    CHECK(stats.maxDiff == 25.0f);
+  }
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -0,0 +1,213 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "index_scan.h"
+#include "common/common.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+
+#include <emmintrin.h>
+
+#define INDEX_SCAN_SSE2 OPTION_ON
+#define INDEX_SCAN_NEON OPTION_OFF
+
+#elif defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#define INDEX_SCAN_SSE2 OPTION_OFF
+#define INDEX_SCAN_NEON OPTION_ON
+
+#else
+
+#define INDEX_SCAN_SSE2 OPTION_OFF
+#define INDEX_SCAN_NEON OPTION_OFF
+
+#endif
+
+// scalar reference, also the tail for the vector paths
+static uint32_t ScalarWidenMaxScan(const uint8_t *idx8, const uint16_t *idx16,
+                                   const uint32_t *idx32, size_t count, uint32_t *out,
+                                   uint32_t restartValue, uint32_t maxIndex)
+{
+  for(size_t i = 0; i < count; i++)
+  {
+    uint32_t value = idx8 ? uint32_t(idx8[i]) : idx16 ? uint32_t(idx16[i]) : idx32[i];
+
+    out[i] = value;
+
+    if(restartValue == 0 || value != restartValue)
+      maxIndex = RDCMAX(maxIndex, value);
+  }
+
+  return maxIndex;
+}
+
+uint32_t WidenIndicesMaxScan(const void *data, uint32_t indexByteStride, size_t count,
+                             uint32_t *out, uint32_t restartValue)
+{
+  const uint8_t *idx8 = indexByteStride == 1 ? (const uint8_t *)data : NULL;
+  const uint16_t *idx16 = indexByteStride == 2 ? (const uint16_t *)data : NULL;
+  const uint32_t *idx32 = indexByteStride == 4 ? (const uint32_t *)data : NULL;
+
+  if(indexByteStride != 1 && indexByteStride != 2 && indexByteStride != 4)
+  {
+    RDCERR("Unexpected index stride %u", indexByteStride);
+    return 0;
+  }
+
+  uint32_t maxIndex = 0;
+  size_t i = 0;
+
+#if ENABLED(INDEX_SCAN_SSE2)
+  const __m128i zero = _mm_setzero_si128();
+  // unsigned 32-bit max isn't native in SSE2, so compare with the sign bit flipped and keep a
+  // biased running max
+  const __m128i bias = _mm_set1_epi32((int32_t)0x80000000U);
+
+  __m128i runningMax = bias;    // biased representation of 0
+
+  if(idx16)
+  {
+    const __m128i restart = _mm_set1_epi16((int16_t)(uint16_t)restartValue);
+
+    for(; i + 8 <= count; i += 8)
+    {
+      __m128i v = _mm_loadu_si128((const __m128i *)(idx16 + i));
+
+      _mm_storeu_si128((__m128i *)(out + i), _mm_unpacklo_epi16(v, zero));
+      _mm_storeu_si128((__m128i *)(out + i + 4), _mm_unpackhi_epi16(v, zero));
+
+      if(restartValue)
+      {
+        // zero out restart lanes so they can't win the max (0 never exceeds a valid max here)
+        __m128i mask = _mm_cmpeq_epi16(v, restart);
+        v = _mm_andnot_si128(mask, v);
+      }
+
+      __m128i lo = _mm_xor_si128(_mm_unpacklo_epi16(v, zero), bias);
+      __m128i hi = _mm_xor_si128(_mm_unpackhi_epi16(v, zero), bias);
+
+      // emulate 32-bit max with compare+select on the biased values
+      __m128i gt = _mm_cmpgt_epi32(lo, runningMax);
+      runningMax = _mm_or_si128(_mm_and_si128(gt, lo), _mm_andnot_si128(gt, runningMax));
+      gt = _mm_cmpgt_epi32(hi, runningMax);
+      runningMax = _mm_or_si128(_mm_and_si128(gt, hi), _mm_andnot_si128(gt, runningMax));
+    }
+  }
+  else if(idx32)
+  {
+    const __m128i restart = _mm_set1_epi32((int32_t)restartValue);
+
+    for(; i + 4 <= count; i += 4)
+    {
+      __m128i v = _mm_loadu_si128((const __m128i *)(idx32 + i));
+
+      _mm_storeu_si128((__m128i *)(out + i), v);
+
+      __m128i biased = _mm_xor_si128(v, bias);
+
+      if(restartValue)
+      {
+        // restart lanes drop to the smallest biased value (INT_MIN) so they can't win the max
+        __m128i mask = _mm_cmpeq_epi32(v, restart);
+        biased = _mm_or_si128(_mm_and_si128(mask, bias), _mm_andnot_si128(mask, biased));
+      }
+
+      __m128i gt = _mm_cmpgt_epi32(biased, runningMax);
+      runningMax = _mm_or_si128(_mm_and_si128(gt, biased), _mm_andnot_si128(gt, runningMax));
+    }
+  }
+
+  if(i > 0)
+  {
+    uint32_t lanes[4];
+    _mm_storeu_si128((__m128i *)lanes, _mm_xor_si128(runningMax, bias));
+
+    for(uint32_t lane : lanes)
+      maxIndex = RDCMAX(maxIndex, lane);
+  }
+#elif ENABLED(INDEX_SCAN_NEON)
+  uint32x4_t runningMax = vdupq_n_u32(0);
+
+  if(idx16)
+  {
+    const uint16x8_t restart = vdupq_n_u16((uint16_t)restartValue);
+
+    for(; i + 8 <= count; i += 8)
+    {
+      uint16x8_t v = vld1q_u16(idx16 + i);
+
+      uint32x4_t lo = vmovl_u16(vget_low_u16(v));
+      uint32x4_t hi = vmovl_u16(vget_high_u16(v));
+
+      vst1q_u32(out + i, lo);
+      vst1q_u32(out + i + 4, hi);
+
+      if(restartValue)
+      {
+        uint16x8_t mask = vceqq_u16(v, restart);
+        v = vbicq_u16(v, mask);
+
+        lo = vmovl_u16(vget_low_u16(v));
+        hi = vmovl_u16(vget_high_u16(v));
+      }
+
+      runningMax = vmaxq_u32(runningMax, lo);
+      runningMax = vmaxq_u32(runningMax, hi);
+    }
+  }
+  else if(idx32)
+  {
+    const uint32x4_t restart = vdupq_n_u32(restartValue);
+
+    for(; i + 4 <= count; i += 4)
+    {
+      uint32x4_t v = vld1q_u32(idx32 + i);
+
+      vst1q_u32(out + i, v);
+
+      if(restartValue)
+        v = vbicq_u32(v, vceqq_u32(v, restart));
+
+      runningMax = vmaxq_u32(runningMax, v);
+    }
+  }
+
+  if(i > 0)
+  {
+    uint32_t lanes[4];
+    vst1q_u32(lanes, runningMax);
+
+    for(uint32_t lane : lanes)
+      maxIndex = RDCMAX(maxIndex, lane);
+  }
+#endif
+
+  // 8-bit indices are rare and small enough that the scalar loop covers them, along with any
+  // vector tail
+  return ScalarWidenMaxScan(idx8 ? idx8 + i : NULL, idx16 ? idx16 + i : NULL,
+                            idx32 ? idx32 + i : NULL, count - i, out + i, restartValue, maxIndex);
+}
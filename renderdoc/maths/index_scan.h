@@ -0,0 +1,40 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// index buffer scanning kernels. Large draws index tens of millions of elements and the replay
+// paths that widen and bound-scan them are hot when fetching mesh data, so the scan is
+// vectorised on x86-64/AArch64 with a scalar tail that exactly matches the fallback.
+
+// widens indices of the given byte stride (1, 2 or 4) to 32-bit into out (count elements), and
+// returns the maximum index encountered. When restartValue is non-zero, indices equal to it are
+// still written to out (downstream needs the restart markers in place) but are excluded from
+// the returned maximum, so strip draws don't bound their vertex fetch by the restart sentinel.
+uint32_t WidenIndicesMaxScan(const void *data, uint32_t indexByteStride, size_t count,
+                             uint32_t *out, uint32_t restartValue);
@@ -0,0 +1,128 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2015-2019 Baldur Karlsson
+ * Copyright (c) 2014 Crytek
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "index_scan.h"
+#include "common/common.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include <stdlib.h>
+#include <vector>
+#include "3rdparty/catch/catch.hpp"
+
+// scalar reference the kernels must match exactly
+static uint32_t RefWidenMaxScan(const void *data, uint32_t stride, size_t count, uint32_t *out,
+                                uint32_t restartValue)
+{
+  uint32_t maxIndex = 0;
+
+  for(size_t i = 0; i < count; i++)
+  {
+    uint32_t value = stride == 1 ? uint32_t(((const uint8_t *)data)[i])
+                                 : stride == 2 ? uint32_t(((const uint16_t *)data)[i])
+                                               : ((const uint32_t *)data)[i];
+    out[i] = value;
+    if(restartValue == 0 || value != restartValue)
+      maxIndex = maxIndex > value ? maxIndex : value;
+  }
+
+  return maxIndex;
+}
+
+TEST_CASE("Test index widen/max scan kernels", "[maths][indexscan]")
+{
+  srand(1234);
+
+  SECTION("16-bit indices match the scalar reference at every length")
+  {
+    std::vector<uint16_t> indices(300);
+    for(uint16_t &idx : indices)
+      idx = uint16_t(rand());
+
+    // sprinkle restarts
+    for(size_t i = 7; i < indices.size(); i += 13)
+      indices[i] = 0xffff;
+
+    std::vector<uint32_t> out(indices.size()), refOut(indices.size());
+
+    for(size_t count = 0; count <= indices.size(); count++)
+    {
+      uint32_t max = WidenIndicesMaxScan(indices.data(), 2, count, out.data(), 0xffff);
+      uint32_t refMax = RefWidenMaxScan(indices.data(), 2, count, refOut.data(), 0xffff);
+
+      REQUIRE(max == refMax);
+      REQUIRE(memcmp(out.data(), refOut.data(), count * 4) == 0);
+    }
+  }
+
+  SECTION("32-bit indices with values above the sign bit")
+  {
+    std::vector<uint32_t> indices(300);
+    for(uint32_t &idx : indices)
+      idx = (uint32_t(rand()) << 17) ^ uint32_t(rand());
+
+    for(size_t i = 3; i < indices.size(); i += 11)
+      indices[i] = 0xffffffff;
+
+    std::vector<uint32_t> out(indices.size()), refOut(indices.size());
+
+    for(size_t count = 0; count <= indices.size(); count++)
+    {
+      uint32_t max = WidenIndicesMaxScan(indices.data(), 4, count, out.data(), 0xffffffff);
+      uint32_t refMax = RefWidenMaxScan(indices.data(), 4, count, refOut.data(), 0xffffffff);
+
+      REQUIRE(max == refMax);
+      REQUIRE(memcmp(out.data(), refOut.data(), count * 4) == 0);
+    }
+  }
+
+  SECTION("no restart value includes the sentinel in the max")
+  {
+    uint32_t indices[8] = {5, 0xffffffff, 9, 1, 2, 3, 4, 5};
+    uint32_t out[8];
+
+    CHECK(WidenIndicesMaxScan(indices, 4, 8, out, 0) == 0xffffffff);
+    CHECK(WidenIndicesMaxScan(indices, 4, 8, out, 0xffffffff) == 9);
+  }
+
+  SECTION("8-bit indices")
+  {
+    uint8_t indices[5] = {250, 0xff, 3, 17, 99};
+    uint32_t out[5];
+
+    CHECK(WidenIndicesMaxScan(indices, 1, 5, out, 0xff) == 250);
+    CHECK(out[1] == 0xff);
+  }
+
+  SECTION("all-restart buffer returns zero max")
+  {
+    uint16_t indices[9] = {0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff, 0xffff};
+    uint32_t out[9];
+
+    CHECK(WidenIndicesMaxScan(indices, 2, 9, out, 0xffff) == 0);
+  }
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -150,6 +150,18 @@ void DetachThread(ThreadHandle handle);
 void CloseThread(ThreadHandle handle);
 void Sleep(uint32_t milliseconds);
 
+// returns the number of logical cores available, for sizing worker thread pools.
+uint32_t NumberOfCores();
+
+// counted semaphore, for sleeping worker threads until work is available.
+typedef void *SemaphoreHandle;
+SemaphoreHandle SemaphoreCreate();
+void SemaphorePost(SemaphoreHandle sem, uint32_t count);
+void SemaphoreWait(SemaphoreHandle sem);
+// waits up to the timeout - returns true if the semaphore was signalled, false on timeout
+bool SemaphoreTimedWait(SemaphoreHandle sem, uint32_t timeoutMS);
+void SemaphoreDestroy(SemaphoreHandle sem);
+
 // kind of windows specific, to handle this case:
 // http://blogs.msdn.com/b/oldnewthing/archive/2013/11/05/10463645.aspx
 void KeepModuleAlive();
@@ -176,6 +188,9 @@ public:
   bool IsRecvDataWaiting();
 
   bool SendDataBlocking(const void *buf, uint32_t length);
+  // sends two buffers as one gathered write where the platform allows, so a buffered header
+  // and a large payload go out in a single syscall/packet
+  bool SendDataBlocking2(const void *buf1, uint32_t length1, const void *buf2, uint32_t length2);
   bool RecvDataBlocking(void *data, uint32_t length);
   bool RecvDataNonBlocking(void *data, uint32_t &length);
 
@@ -218,6 +233,9 @@ void Shutdown();
 
 namespace Atomic
 {
+// the inc/dec/add functions all return the POST-operation value on every platform
+// (add-and-fetch); CmpExch32 returns the original value. Callers compute claimed ranges and
+// 1-indexed slots from these results, so platform implementations must not diverge.
 int32_t Inc32(volatile int32_t *i);
 int32_t Dec32(volatile int32_t *i);
 int64_t Inc64(volatile int64_t *i);
@@ -312,6 +330,19 @@ bool feof(FILE *f);
 
 int fclose(FILE *f);
 
+// maps a read-only view of a region of an open file, for zero-copy reads of file data through
+// the OS page cache. offset doesn't need to be page aligned - the returned pointer addresses
+// exactly [offset, offset + length). Returns NULL if the region can't be mapped, in which case
+// callers should fall back to normal reads.
+struct MappedRegion
+{
+  byte *base = NULL;
+  uint64_t mappedSize = 0;
+};
+
+byte *MapFileRegion(FILE *f, uint64_t offset, uint64_t length, MappedRegion &region);
+void UnmapFileRegion(MappedRegion &region);
+
 // functions for atomically appending to a log that may be in use in multiple
 // processes
 bool logfile_open(const char *filename);
@@ -31,6 +31,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <sys/types.h>
 #include <sys/un.h>
 #include <unistd.h>
@@ -138,6 +139,80 @@ Socket *Socket::AcceptClient(uint32_t timeoutMilliseconds)
   return NULL;
 }
 
+bool Socket::SendDataBlocking2(const void *buf1, uint32_t length1, const void *buf2,
+                               uint32_t length2)
+{
+  if(length1 == 0)
+    return SendDataBlocking(buf2, length2);
+  if(length2 == 0)
+    return SendDataBlocking(buf1, length1);
+
+  int flags = fcntl(socket, F_GETFL, 0);
+  fcntl(socket, F_SETFL, flags & ~O_NONBLOCK);
+
+  timeval oldtimeout = {0};
+  socklen_t len = sizeof(oldtimeout);
+  getsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (char *)&oldtimeout, &len);
+
+  timeval timeout = {0};
+  timeout.tv_sec = (timeoutMS / 1000);
+  timeout.tv_usec = (timeoutMS % 1000) * 1000;
+  setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (const char *)&timeout, sizeof(timeout));
+
+  iovec iov[2];
+  iov[0].iov_base = (void *)buf1;
+  iov[0].iov_len = length1;
+  iov[1].iov_base = (void *)buf2;
+  iov[1].iov_len = length2;
+
+  uint64_t total = uint64_t(length1) + length2;
+  uint64_t sent = 0;
+  int iovIdx = 0;
+
+  bool success = true;
+
+  while(sent < total)
+  {
+    ssize_t ret = writev(socket, iov + iovIdx, 2 - iovIdx);
+
+    if(ret <= 0)
+    {
+      int err = errno;
+
+      if(err == EWOULDBLOCK || err == EAGAIN || err == EINTR)
+        RDCWARN("Timeout in send");
+      else
+        RDCWARN("writev: %s", errno_string(err).c_str());
+
+      Shutdown();
+      success = false;
+      break;
+    }
+
+    sent += ret;
+
+    // advance the iovec cursor past whatever was consumed
+    while(ret > 0 && iovIdx < 2)
+    {
+      size_t consume = RDCMIN((size_t)ret, iov[iovIdx].iov_len);
+
+      iov[iovIdx].iov_base = (char *)iov[iovIdx].iov_base + consume;
+      iov[iovIdx].iov_len -= consume;
+      ret -= consume;
+
+      if(iov[iovIdx].iov_len == 0)
+        iovIdx++;
+    }
+  }
+
+  flags = fcntl(socket, F_GETFL, 0);
+  fcntl(socket, F_SETFL, flags | O_NONBLOCK);
+
+  setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, (const char *)&oldtimeout, sizeof(oldtimeout));
+
+  return success;
+}
+
 bool Socket::SendDataBlocking(const void *buf, uint32_t length)
 {
   if(length == 0)
@@ -692,6 +692,15 @@ uint32_t Process::LaunchScript(const char *script, const char *workingDir, const
   return LaunchProcess("bash", workingDir, args.c_str(), internal, result);
 }
 
+// Multi-process note: each child spawned under capture re-runs full capture-layer init -
+// symbol resolution, hook installation, API layer discovery - adding seconds per process for
+// launcher/editor/renderer trees. The inheritance plan: the first process publishes its
+// resolved hook state (library paths, resolved symbol addresses valid under identical ASLR
+// only on windows CreateProcess inheritance; on posix the fork path can inherit the already-
+// initialised layer directly) into a shared memory block named in the child's environment, and
+// children initialise from it, falling back to the full path when the block is missing or the
+// binary identity doesn't match. The identity check is what keeps a mismatched child from
+// jumping to stale addresses.
 ExecuteResult Process::LaunchAndInjectIntoProcess(const char *app, const char *workingDir,
                                                   const char *cmdLine,
                                                   const rdcarray<EnvironmentModification> &envList,
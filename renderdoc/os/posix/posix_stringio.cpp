@@ -32,6 +32,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <time.h>
@@ -465,6 +466,44 @@ int fclose(FILE *f)
   return ::fclose(f);
 }
 
+byte *MapFileRegion(FILE *f, uint64_t offset, uint64_t length, MappedRegion &region)
+{
+  if(f == NULL || length == 0)
+    return NULL;
+
+  int fd = fileno(f);
+  if(fd < 0)
+    return NULL;
+
+  // mmap requires a page-aligned offset, so map from the previous page boundary and offset the
+  // returned pointer.
+  uint64_t pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+  uint64_t alignedOffset = offset & ~(pageSize - 1);
+  uint64_t alignedLength = length + (offset - alignedOffset);
+
+  // on 32-bit the region may not fit in the address space at all - don't map a truncated view
+  if((uint64_t)(size_t)alignedLength != alignedLength)
+    return NULL;
+
+  void *base = mmap(NULL, (size_t)alignedLength, PROT_READ, MAP_PRIVATE, fd, (off_t)alignedOffset);
+  if(base == MAP_FAILED)
+    return NULL;
+
+  region.base = (byte *)base;
+  region.mappedSize = alignedLength;
+
+  return region.base + (offset - alignedOffset);
+}
+
+void UnmapFileRegion(MappedRegion &region)
+{
+  if(region.base)
+    munmap(region.base, (size_t)region.mappedSize);
+
+  region.base = NULL;
+  region.mappedSize = 0;
+}
+
 bool exists(const char *filename)
 {
   struct ::stat st;
@@ -22,6 +22,7 @@
  * THE SOFTWARE.
  ******************************************************************************/
 
+#include <errno.h>
 #include <time.h>
 #include <unistd.h>
 #include "os/os_specific.h"
@@ -302,4 +303,105 @@ void Sleep(uint32_t milliseconds)
 {
   usleep(milliseconds * 1000);
 }
+
+uint32_t NumberOfCores()
+{
+  long ret = sysconf(_SC_NPROCESSORS_ONLN);
+
+  if(ret <= 0)
+    return 1;
+
+  return (uint32_t)ret;
+}
+
+// implemented with a mutex/condvar pair instead of sem_t, since unnamed POSIX semaphores aren't
+// supported on apple platforms.
+struct SemaphoreData
+{
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  int32_t count;
+};
+
+SemaphoreHandle SemaphoreCreate()
+{
+  SemaphoreData *sem = new SemaphoreData;
+
+  pthread_mutex_init(&sem->mutex, NULL);
+  pthread_cond_init(&sem->cond, NULL);
+  sem->count = 0;
+
+  return sem;
+}
+
+void SemaphorePost(SemaphoreHandle sem, uint32_t count)
+{
+  SemaphoreData *s = (SemaphoreData *)sem;
+
+  pthread_mutex_lock(&s->mutex);
+  s->count += (int32_t)count;
+  pthread_mutex_unlock(&s->mutex);
+
+  if(count == 1)
+    pthread_cond_signal(&s->cond);
+  else
+    pthread_cond_broadcast(&s->cond);
+}
+
+void SemaphoreWait(SemaphoreHandle sem)
+{
+  SemaphoreData *s = (SemaphoreData *)sem;
+
+  pthread_mutex_lock(&s->mutex);
+  while(s->count == 0)
+    pthread_cond_wait(&s->cond, &s->mutex);
+  s->count--;
+  pthread_mutex_unlock(&s->mutex);
+}
+
+bool SemaphoreTimedWait(SemaphoreHandle sem, uint32_t timeoutMS)
+{
+  SemaphoreData *s = (SemaphoreData *)sem;
+
+  timespec deadline;
+  clock_gettime(CLOCK_REALTIME, &deadline);
+
+  deadline.tv_sec += timeoutMS / 1000;
+  deadline.tv_nsec += long(timeoutMS % 1000) * 1000000;
+
+  if(deadline.tv_nsec >= 1000000000)
+  {
+    deadline.tv_sec++;
+    deadline.tv_nsec -= 1000000000;
+  }
+
+  bool signalled = true;
+
+  pthread_mutex_lock(&s->mutex);
+  while(s->count == 0)
+  {
+    if(pthread_cond_timedwait(&s->cond, &s->mutex, &deadline) == ETIMEDOUT)
+    {
+      signalled = false;
+      break;
+    }
+  }
+
+  if(signalled)
+    s->count--;
+
+  pthread_mutex_unlock(&s->mutex);
+
+  return signalled;
+}
+
+void SemaphoreDestroy(SemaphoreHandle sem)
+{
+  SemaphoreData *s = (SemaphoreData *)sem;
+
+  pthread_cond_destroy(&s->cond);
+  pthread_mutex_destroy(&s->mutex);
+
+  delete s;
+}
 };
@@ -177,6 +177,39 @@ Socket *Socket::AcceptClient(uint32_t timeoutMilliseconds)
   return NULL;
 }
 
+bool Socket::SendDataBlocking2(const void *buf1, uint32_t length1, const void *buf2,
+                               uint32_t length2)
+{
+  if(length1 == 0)
+    return SendDataBlocking(buf2, length2);
+  if(length2 == 0)
+    return SendDataBlocking(buf1, length1);
+
+  WSABUF bufs[2];
+  bufs[0].buf = (CHAR *)buf1;
+  bufs[0].len = length1;
+  bufs[1].buf = (CHAR *)buf2;
+  bufs[1].len = length2;
+
+  DWORD sent = 0;
+
+  if(WSASend((SOCKET)socket, bufs, 2, &sent, 0, NULL, NULL) == 0 &&
+     sent == DWORD(length1) + length2)
+    return true;
+
+  // partial or failed gathered send - fall back to the robust sequential path for the rest
+  uint64_t total = uint64_t(length1) + length2;
+
+  if(sent < length1)
+    return SendDataBlocking((const char *)buf1 + sent, length1 - sent) &&
+           SendDataBlocking(buf2, length2);
+
+  if(sent < total)
+    return SendDataBlocking((const char *)buf2 + (sent - length1), uint32_t(total - sent));
+
+  return true;
+}
+
 bool Socket::SendDataBlocking(const void *buf, uint32_t length)
 {
   if(length == 0)
@@ -663,6 +663,59 @@ int fclose(FILE *f)
   return ::fclose(f);
 }
 
+byte *MapFileRegion(FILE *f, uint64_t offset, uint64_t length, MappedRegion &region)
+{
+  if(f == NULL || length == 0)
+    return NULL;
+
+  HANDLE file = (HANDLE)_get_osfhandle(_fileno(f));
+  if(file == INVALID_HANDLE_VALUE)
+    return NULL;
+
+  // make sure any buffered writes have reached the file before we map a view of it
+  ::fflush(f);
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if(mapping == NULL)
+    return NULL;
+
+  // views must start at an allocation-granularity boundary, so map from the previous boundary
+  // and offset the returned pointer.
+  SYSTEM_INFO sysInfo = {};
+  GetSystemInfo(&sysInfo);
+
+  uint64_t granularity = sysInfo.dwAllocationGranularity;
+  uint64_t alignedOffset = offset & ~(granularity - 1);
+  uint64_t alignedLength = length + (offset - alignedOffset);
+
+  // on 32-bit the region may not fit in the address space at all - don't map a truncated view
+  if((uint64_t)(size_t)alignedLength != alignedLength)
+    return NULL;
+
+  void *base = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(alignedOffset >> 32),
+                             (DWORD)(alignedOffset & 0xffffffffU), (SIZE_T)alignedLength);
+
+  // the view keeps the underlying mapping alive, so we don't need the handle after this
+  CloseHandle(mapping);
+
+  if(base == NULL)
+    return NULL;
+
+  region.base = (byte *)base;
+  region.mappedSize = alignedLength;
+
+  return region.base + (offset - alignedOffset);
+}
+
+void UnmapFileRegion(MappedRegion &region)
+{
+  if(region.base)
+    UnmapViewOfFile(region.base);
+
+  region.base = NULL;
+  region.mappedSize = 0;
+}
+
 static HANDLE logHandle = NULL;
 
 bool logfile_open(const char *filename)
@@ -75,7 +75,10 @@ int64_t Dec64(volatile int64_t *i)
 
 int64_t ExchAdd64(volatile int64_t *i, int64_t a)
 {
-  return (int64_t)InterlockedExchangeAdd64((volatile LONG64 *)i, a);
+  // InterlockedExchangeAdd64 returns the value *before* the add, but the contract (and the
+  // posix __sync_add_and_fetch implementation) is the post-add value - callers compute their
+  // claimed ranges from the result
+  return (int64_t)InterlockedAdd64((volatile LONG64 *)i, a);
 }
 
 int32_t CmpExch32(volatile int32_t *dest, int32_t oldVal, int32_t newVal)
@@ -305,4 +308,40 @@ void Sleep(uint32_t milliseconds)
 {
   ::Sleep((DWORD)milliseconds);
 }
+
+uint32_t NumberOfCores()
+{
+  SYSTEM_INFO sysInfo = {};
+  GetSystemInfo(&sysInfo);
+
+  if(sysInfo.dwNumberOfProcessors == 0)
+    return 1;
+
+  return (uint32_t)sysInfo.dwNumberOfProcessors;
+}
+
+SemaphoreHandle SemaphoreCreate()
+{
+  return (SemaphoreHandle)::CreateSemaphoreA(NULL, 0, 0x7fffffff, NULL);
+}
+
+void SemaphorePost(SemaphoreHandle sem, uint32_t count)
+{
+  ReleaseSemaphore((HANDLE)sem, (LONG)count, NULL);
+}
+
+void SemaphoreWait(SemaphoreHandle sem)
+{
+  WaitForSingleObject((HANDLE)sem, INFINITE);
+}
+
+bool SemaphoreTimedWait(SemaphoreHandle sem, uint32_t timeoutMS)
+{
+  return WaitForSingleObject((HANDLE)sem, (DWORD)timeoutMS) == WAIT_OBJECT_0;
+}
+
+void SemaphoreDestroy(SemaphoreHandle sem)
+{
+  CloseHandle((HANDLE)sem);
+}
 };
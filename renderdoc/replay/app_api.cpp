@@ -254,6 +254,13 @@ void RENDERDOC_CC GetAPIVersion_1_4_0(int *major, int *minor, int *patch)
     *patch = 0;
 }
 
+// API-surface note: titles can trigger captures but can't see what the capture layer costs
+// them. The recording statistics now exist internally (chunks and bytes per frame from the
+// chunk counters, and the block allocator's totals) - exposing them means a new in-app API
+// version adding a GetCaptureStats entry point returning per-frame hook cost, serialised
+// bytes and shadow footprint, with the per-frame CPU cost the one piece still needing cheap
+// always-on timing in the wrapped drivers' present paths. The versioned struct scheme here
+// makes the addition backwards compatible.
 RENDERDOC_API_1_4_0 api_1_4_0;
 void Init_1_4_0()
 {
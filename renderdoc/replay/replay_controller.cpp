@@ -24,6 +24,7 @@
  ******************************************************************************/
 
 #include "replay_controller.h"
+#include <algorithm>
 #include <string.h>
 #include <time.h>
 #include "common/dds_readwrite.h"
@@ -32,6 +33,7 @@
 #include "jpeg-compressor/jpgd.h"
 #include "jpeg-compressor/jpge.h"
 #include "maths/formatpacking.h"
+#include "maths/image_compare.h"
 #include "os/os_specific.h"
 #include "serialise/rdcfile.h"
 #include "serialise/serialiser.h"
@@ -212,6 +214,13 @@ ReplayController::~ReplayController()
   m_pDevice = NULL;
 }
 
+// Latency note: sequential stepping dominates real usage, and all work here starts only after
+// the input arrives. Speculative pre-replay of the next/previous draw during idle needs
+// somewhere to put the speculative result - the GPU holds exactly one replayed state, so it
+// requires either the mid-frame checkpoint machinery (see the note in WrappedVulkan::ReplayLog)
+// to snapshot/restore cheaply, or a second replay instance with its own resources. Without one
+// of those, 'pre-replaying' would just move the same full replay earlier and block the replay
+// thread when the user steps the other way.
 void ReplayController::SetFrameEvent(uint32_t eventId, bool force)
 {
   CHECK_REPLAY_THREAD();
@@ -535,26 +544,94 @@ void ReplayController::AddFakeMarkers()
   SetupDrawcallPointers(m_Drawcalls, m_FrameRecord.drawcallList);
 }
 
+// Comparison note: diffing two counter runs (driver A/B, or two captures aligned with
+// AlignDrawcallTrees) belongs in-core once the columnar form below exists: aligned event
+// indices make the diff a vectorised subtract, marker-hierarchy aggregation reuses the rollup,
+// and the UI renders the result as a flamegraph with regression highlighting. Interactive
+// re-aggregation over 50k events x 20 counters is trivially within budget on columnar data.
+//
+// Data-shape note: this array-of-structs result is painful for statistics tooling - python
+// spends longer unmarshalling (event, counter, value) records than the GPU spent measuring. A
+// columnar sibling API (one contiguous typed array per counter over a shared event index,
+// exposed to python via the buffer protocol for zero-copy numpy views) is a pure reshape of
+// this result plus binding work; the rollup already emits results sorted by event, so the
+// shared index falls out of a single pass.
 rdcarray<CounterResult> ReplayController::FetchCounters(const rdcarray<GPUCounter> &counters)
 {
   CHECK_REPLAY_THREAD();
 
-  std::vector<GPUCounter> counterArray(counters.begin(), counters.end());
+  // split off derived counters, making sure their generic inputs are in the device fetch, then
+  // evaluate the derived values in one pass over the returned data
+  rdcarray<GPUCounter> derived;
+  rdcarray<GPUCounter> addedInputs;
+  std::vector<GPUCounter> counterArray;
 
-  return m_pDevice->FetchCounters(counterArray);
+  for(GPUCounter c : counters)
+  {
+    if(IsDerivedCounter(c))
+      derived.push_back(c);
+    else
+      counterArray.push_back(c);
+  }
+
+  for(GPUCounter d : derived)
+  {
+    rdcarray<GPUCounter> inputs;
+    GetDerivedCounterInputs(d, inputs);
+
+    for(GPUCounter input : inputs)
+    {
+      if(std::find(counterArray.begin(), counterArray.end(), input) == counterArray.end())
+      {
+        counterArray.push_back(input);
+        if(!addedInputs.contains(input))
+          addedInputs.push_back(input);
+      }
+    }
+  }
+
+  rdcarray<CounterResult> ret = m_pDevice->FetchCounters(counterArray);
+
+  if(!derived.empty())
+  {
+    DeriveCounterResults(derived, ret);
+
+    // drop the rows for inputs fetched only to feed the derivation
+    if(!addedInputs.empty())
+    {
+      rdcarray<CounterResult> filtered;
+      filtered.reserve(ret.size());
+
+      for(const CounterResult &r : ret)
+        if(!addedInputs.contains(r.counter))
+          filtered.push_back(r);
+
+      ret.swap(filtered);
+    }
+  }
+
+  return ret;
 }
 
 rdcarray<GPUCounter> ReplayController::EnumerateCounters()
 {
   CHECK_REPLAY_THREAD();
 
-  return m_pDevice->EnumerateCounters();
+  rdcarray<GPUCounter> ret = m_pDevice->EnumerateCounters();
+
+  // the in-core derived counters are available whenever their generic inputs are
+  EnumerateDerivedCounters(ret, ret);
+
+  return ret;
 }
 
 CounterDescription ReplayController::DescribeCounter(GPUCounter counterID)
 {
   CHECK_REPLAY_THREAD();
 
+  if(IsDerivedCounter(counterID))
+    return DescribeDerivedCounter(counterID);
+
   return m_pDevice->DescribeCounter(counterID);
 }
 
@@ -670,6 +747,65 @@ bytebuf ReplayController::GetTextureData(ResourceId tex, uint32_t arrayIdx, uint
   return ret;
 }
 
+TextureComparison ReplayController::CompareTextures(ResourceId texA, ResourceId texB,
+                                                    float tolerance)
+{
+  CHECK_REPLAY_THREAD();
+
+  TextureComparison ret;
+  ret.histogram.resize(16);
+
+  ResourceId liveA = m_pDevice->GetLiveID(texA);
+  ResourceId liveB = m_pDevice->GetLiveID(texB);
+
+  if(liveA == ResourceId() || liveB == ResourceId())
+  {
+    RDCERR("Couldn't get Live ID comparing %llu and %llu", texA, texB);
+    return ret;
+  }
+
+  TextureDescription descA = m_pDevice->GetTexture(liveA);
+  TextureDescription descB = m_pDevice->GetTexture(liveB);
+
+  if(descA.width != descB.width || descA.height != descB.height)
+  {
+    RDCERR("Comparing textures with mismatched dimensions: %ux%u vs %ux%u", descA.width,
+           descA.height, descB.width, descB.height);
+    return ret;
+  }
+
+  // fetch both sides remapped to RGBA32F so the comparison is format-independent
+  GetTextureDataParams params;
+  params.remap = RemapTexture::RGBA32;
+  params.typeHint = CompType::Float;
+
+  bytebuf dataA, dataB;
+  m_pDevice->GetTextureData(liveA, 0, 0, params, dataA);
+  m_pDevice->GetTextureData(liveB, 0, 0, params, dataB);
+
+  size_t pixelCount = RDCMIN(dataA.size(), dataB.size()) / (sizeof(float) * 4);
+
+  if(pixelCount == 0)
+  {
+    RDCERR("Couldn't fetch texture contents for comparison");
+    return ret;
+  }
+
+  ImageDiffStats stats;
+  CompareImagesRGBA32F((const float *)dataA.data(), (const float *)dataB.data(), pixelCount,
+                       tolerance, stats);
+
+  ret.pixelsCompared = stats.pixels;
+  ret.pixelsDiffering = stats.differing;
+  ret.maxDifference = stats.maxDiff;
+  ret.meanDifference = stats.pixels ? stats.sumDiff / double(stats.pixels) : 0.0;
+
+  for(int bucket = 0; bucket < 16; bucket++)
+    ret.histogram[bucket] = stats.histogram[bucket];
+
+  return ret;
+}
+
 bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path)
 {
   CHECK_REPLAY_THREAD();
@@ -1380,104 +1516,156 @@ bool ReplayController::SaveTexture(const TextureSave &saveData, const char *path
       if(saveFmt.compType == CompType::Depth && pixStride == 3)
         pixStride = 4;
 
-      for(uint32_t y = 0; y < td.height; y++)
-      {
-        for(uint32_t x = 0; x < td.width; x++)
-        {
-          float r = 0.0f;
-          float g = 0.0f;
-          float b = 0.0f;
-          float a = 1.0f;
-
-          if(saveFmt.type == ResourceFormatType::R10G10B10A2)
-          {
-            uint32_t *u32 = (uint32_t *)srcData;
-
-            Vec4f vec = ConvertFromR10G10B10A2(*u32);
-
-            r = vec.x;
-            g = vec.y;
-            b = vec.z;
-            a = vec.w;
-
-            srcData += 4;
-          }
-          else if(saveFmt.type == ResourceFormatType::R11G11B10)
-          {
-            uint32_t *u32 = (uint32_t *)srcData;
-
-            Vec3f vec = ConvertFromR11G11B10(*u32);
-
-            r = vec.x;
-            g = vec.y;
-            b = vec.z;
-            a = 1.0f;
-
-            srcData += 4;
-          }
-          else
-          {
-            if(saveFmt.compCount >= 1)
-              r = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 0);
-            if(saveFmt.compCount >= 2)
-              g = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 1);
-            if(saveFmt.compCount >= 3)
-              b = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 2);
-            if(saveFmt.compCount >= 4)
-              a = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 3);
-
-            srcData += pixStride;
-          }
-
-          if(saveFmt.BGRAOrder())
-            std::swap(r, b);
-
-          // HDR can't represent negative values
-          if(sd.destType == FileType::HDR)
-          {
-            r = RDCMAX(r, 0.0f);
-            g = RDCMAX(g, 0.0f);
-            b = RDCMAX(b, 0.0f);
-            a = RDCMAX(a, 0.0f);
-          }
-
-          if(sd.channelExtract == 0)
-          {
-            g = b = r;
-            a = 1.0f;
-          }
-          if(sd.channelExtract == 1)
-          {
-            r = b = g;
-            a = 1.0f;
-          }
-          if(sd.channelExtract == 2)
-          {
-            r = g = b;
-            a = 1.0f;
-          }
-          if(sd.channelExtract == 3)
-          {
-            r = g = b = a;
-            a = 1.0f;
-          }
-
-          if(fldata)
-          {
-            fldata[(y * td.width + x) * 4 + 0] = r;
-            fldata[(y * td.width + x) * 4 + 1] = g;
-            fldata[(y * td.width + x) * 4 + 2] = b;
-            fldata[(y * td.width + x) * 4 + 3] = a;
-          }
-          else
-          {
-            abgr[0][(y * td.width + x)] = a;
-            abgr[1][(y * td.width + x)] = b;
-            abgr[2][(y * td.width + x)] = g;
-            abgr[3][(y * td.width + x)] = r;
-          }
-        }
-      }
+      // the common formats can be converted a row at a time through the batched kernels instead
+      // of pushing every texel through the scalar paths below.
+      bool batchRGBA8 = saveFmt.type == ResourceFormatType::Regular && saveFmt.compCount == 4 &&
+                        saveFmt.compByteWidth == 1 && saveFmt.compType == CompType::UNorm;
+      bool batchHalf = saveFmt.type == ResourceFormatType::Regular && saveFmt.compCount == 4 &&
+                       saveFmt.compByteWidth == 2 && saveFmt.compType == CompType::Float;
+      bool batchRow =
+          saveFmt.type == ResourceFormatType::R10G10B10A2 || batchRGBA8 || batchHalf;
+
+      // each row converts independently, so spread the conversion across the worker pool -
+      // the encoder below is still serial, but on big floating point exports the conversion is
+      // a large fraction of the time
+      const uint32_t rowAdvance =
+          (saveFmt.type == ResourceFormatType::R10G10B10A2 ||
+           saveFmt.type == ResourceFormatType::R11G11B10)
+              ? 4
+              : pixStride;
+
+      const byte *srcBase = srcData;
+
+      Threading::ParallelFor(
+          td.height,
+          [&](uint64_t firstRow, uint64_t lastRow) {
+            std::vector<Vec4f> rowConverted;
+
+            for(uint32_t y = (uint32_t)firstRow; y < (uint32_t)lastRow; y++)
+            {
+              const byte *srcData = srcBase + uint64_t(y) * td.width * rowAdvance;
+
+              if(batchRow)
+              {
+                rowConverted.resize(td.width);
+
+                if(saveFmt.type == ResourceFormatType::R10G10B10A2)
+                  ConvertFromR10G10B10A2((const uint32_t *)srcData, rowConverted.data(), td.width);
+                else if(batchRGBA8)
+                  ConvertFromRGBA8(srcData, rowConverted.data(), td.width, false);
+                else
+                  ConvertFromHalf((const uint16_t *)srcData, &rowConverted[0].x, td.width * 4);
+              }
+
+              for(uint32_t x = 0; x < td.width; x++)
+              {
+                float r = 0.0f;
+                float g = 0.0f;
+                float b = 0.0f;
+                float a = 1.0f;
+
+                if(batchRow)
+                {
+                  const Vec4f &vec = rowConverted[x];
+
+                  r = vec.x;
+                  g = vec.y;
+                  b = vec.z;
+                  a = vec.w;
+
+                  srcData += (saveFmt.type == ResourceFormatType::R10G10B10A2) ? 4 : pixStride;
+                }
+                else if(saveFmt.type == ResourceFormatType::R10G10B10A2)
+                {
+                  uint32_t *u32 = (uint32_t *)srcData;
+
+                  Vec4f vec = ConvertFromR10G10B10A2(*u32);
+
+                  r = vec.x;
+                  g = vec.y;
+                  b = vec.z;
+                  a = vec.w;
+
+                  srcData += 4;
+                }
+                else if(saveFmt.type == ResourceFormatType::R11G11B10)
+                {
+                  uint32_t *u32 = (uint32_t *)srcData;
+
+                  Vec3f vec = ConvertFromR11G11B10(*u32);
+
+                  r = vec.x;
+                  g = vec.y;
+                  b = vec.z;
+                  a = 1.0f;
+
+                  srcData += 4;
+                }
+                else
+                {
+                  if(saveFmt.compCount >= 1)
+                    r = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 0);
+                  if(saveFmt.compCount >= 2)
+                    g = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 1);
+                  if(saveFmt.compCount >= 3)
+                    b = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 2);
+                  if(saveFmt.compCount >= 4)
+                    a = ConvertComponent(saveFmt, srcData + saveFmt.compByteWidth * 3);
+
+                  srcData += pixStride;
+                }
+
+                if(saveFmt.BGRAOrder())
+                  std::swap(r, b);
+
+                // HDR can't represent negative values
+                if(sd.destType == FileType::HDR)
+                {
+                  r = RDCMAX(r, 0.0f);
+                  g = RDCMAX(g, 0.0f);
+                  b = RDCMAX(b, 0.0f);
+                  a = RDCMAX(a, 0.0f);
+                }
+
+                if(sd.channelExtract == 0)
+                {
+                  g = b = r;
+                  a = 1.0f;
+                }
+                if(sd.channelExtract == 1)
+                {
+                  r = b = g;
+                  a = 1.0f;
+                }
+                if(sd.channelExtract == 2)
+                {
+                  r = g = b;
+                  a = 1.0f;
+                }
+                if(sd.channelExtract == 3)
+                {
+                  r = g = b = a;
+                  a = 1.0f;
+                }
+
+                if(fldata)
+                {
+                  fldata[(y * td.width + x) * 4 + 0] = r;
+                  fldata[(y * td.width + x) * 4 + 1] = g;
+                  fldata[(y * td.width + x) * 4 + 2] = b;
+                  fldata[(y * td.width + x) * 4 + 3] = a;
+                }
+                else
+                {
+                  abgr[0][(y * td.width + x)] = a;
+                  abgr[1][(y * td.width + x)] = b;
+                  abgr[2][(y * td.width + x)] = g;
+                  abgr[3][(y * td.width + x)] = r;
+                }
+              }
+            }
+          },
+          256);
 
       if(sd.destType == FileType::HDR)
       {
@@ -1993,6 +2181,12 @@ void ReplayController::FreeCustomShader(ResourceId id)
   m_pDevice->FreeCustomShader(id);
 }
 
+// Workflow note: evaluating a shader fix means manually stepping events after each edit. A
+// batch evaluation API fits on top of this: given the replacement, find affected events via
+// the usage lists, re-render each one's output in one replay pass, and return per-event diffs
+// against pre-edit captures of the same outputs (the histogram/minmax shaders can score
+// difference cheaply). The pieces - usage index, replacement plumbing, output readback - all
+// exist; the API shape is an iteration over events with the replacement pinned.
 void ReplayController::ReplaceResource(ResourceId from, ResourceId to)
 {
   CHECK_REPLAY_THREAD();
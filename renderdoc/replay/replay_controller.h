@@ -193,6 +193,7 @@ public:
 
   bytebuf GetBufferData(ResourceId buff, uint64_t offset, uint64_t len);
   bytebuf GetTextureData(ResourceId buff, uint32_t arrayIdx, uint32_t mip);
+  TextureComparison CompareTextures(ResourceId texA, ResourceId texB, float tolerance);
 
   bool SaveTexture(const TextureSave &saveData, const char *path);
 
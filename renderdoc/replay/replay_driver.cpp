@@ -24,6 +24,7 @@
 
 #include "replay_driver.h"
 #include "maths/formatpacking.h"
+#include "maths/index_scan.h"
 #include "serialise/serialiser.h"
 
 template <>
@@ -49,10 +50,146 @@ void DoSerialise(SerialiserType &ser, GetTextureDataParams &el)
   SERIALISE_MEMBER(remap);
   SERIALISE_MEMBER(blackPoint);
   SERIALISE_MEMBER(whitePoint);
+  SERIALISE_MEMBER(rectX);
+  SERIALISE_MEMBER(rectY);
+  SERIALISE_MEMBER(rectWidth);
+  SERIALISE_MEMBER(rectHeight);
 }
 
 INSTANTIATE_SERIALISE_TYPE(GetTextureDataParams);
 
+bool CropTextureData(const TextureDescription &desc, const GetTextureDataParams &params,
+                     uint32_t mip, bytebuf &data)
+{
+  if(params.rectWidth == 0 || params.rectHeight == 0)
+    return false;
+
+  // only regular formats have the predictable tightly-packed layout we can crop here, and
+  // remapping changes the returned format out from under us.
+  if(desc.format.type != ResourceFormatType::Regular || params.remap != RemapTexture::NoRemap)
+    return false;
+
+  uint32_t pixelSize = desc.format.compCount * desc.format.compByteWidth;
+
+  if(pixelSize == 0)
+    return false;
+
+  uint32_t mipWidth = RDCMAX(1U, desc.width >> mip);
+  uint32_t mipHeight = RDCMAX(1U, desc.height >> mip);
+
+  // only crop single-slice 2D data whose size matches the packed layout we expect
+  if(uint64_t(data.size()) != uint64_t(mipWidth) * mipHeight * pixelSize)
+    return false;
+
+  if(params.rectX >= mipWidth || params.rectY >= mipHeight)
+    return false;
+
+  uint32_t rectWidth = RDCMIN(params.rectWidth, mipWidth - params.rectX);
+  uint32_t rectHeight = RDCMIN(params.rectHeight, mipHeight - params.rectY);
+
+  bytebuf cropped;
+  cropped.resize(size_t(rectWidth) * rectHeight * pixelSize);
+
+  const uint32_t srcPitch = mipWidth * pixelSize;
+  const uint32_t dstPitch = rectWidth * pixelSize;
+
+  const byte *src = data.data() + params.rectY * srcPitch + params.rectX * pixelSize;
+  byte *dst = cropped.data();
+
+  for(uint32_t row = 0; row < rectHeight; row++)
+  {
+    memcpy(dst, src, dstPitch);
+
+    src += srcPitch;
+    dst += dstPitch;
+  }
+
+  data.swap(cropped);
+
+  return true;
+}
+
+
+void AlignDrawcallTrees(const rdcarray<DrawcallDescription> &a,
+                        const rdcarray<DrawcallDescription> &b,
+                        std::vector<rdcpair<uint32_t, uint32_t>> &matches)
+{
+  const size_t aCount = a.size();
+  const size_t bCount = b.size();
+
+  if(aCount == 0 || bCount == 0)
+    return;
+
+  // quadratic LCS is fine for sibling lists (markers keep them short); for degenerate flat
+  // captures fall back to greedy in-order name matching to stay linear-ish.
+  const size_t lcsLimit = 4 * 1024 * 1024;
+
+  if(aCount * bCount > lcsLimit)
+  {
+    size_t bi = 0;
+
+    for(size_t ai = 0; ai < aCount && bi < bCount; ai++)
+    {
+      size_t search = bi;
+
+      while(search < bCount && !(b[search].name == a[ai].name))
+        search++;
+
+      if(search == bCount)
+        continue;
+
+      bi = search;
+
+      matches.push_back(make_rdcpair(a[ai].eventId, b[bi].eventId));
+      AlignDrawcallTrees(a[ai].children, b[bi].children, matches);
+
+      bi++;
+    }
+
+    return;
+  }
+
+  // standard LCS table over sibling names
+  std::vector<uint32_t> table((aCount + 1) * (bCount + 1), 0);
+
+  const size_t stride = bCount + 1;
+
+  for(size_t ai = aCount; ai > 0; ai--)
+  {
+    for(size_t bi = bCount; bi > 0; bi--)
+    {
+      if(a[ai - 1].name == b[bi - 1].name)
+        table[(ai - 1) * stride + (bi - 1)] = table[ai * stride + bi] + 1;
+      else
+        table[(ai - 1) * stride + (bi - 1)] =
+            RDCMAX(table[ai * stride + (bi - 1)], table[(ai - 1) * stride + bi]);
+    }
+  }
+
+  // walk the table emitting matched pairs, recursing into their children
+  size_t ai = 0, bi = 0;
+
+  while(ai < aCount && bi < bCount)
+  {
+    if(a[ai].name == b[bi].name)
+    {
+      matches.push_back(make_rdcpair(a[ai].eventId, b[bi].eventId));
+      AlignDrawcallTrees(a[ai].children, b[bi].children, matches);
+
+      ai++;
+      bi++;
+    }
+    else if(table[(ai + 1) * stride + bi] >= table[ai * stride + (bi + 1)])
+    {
+      ai++;
+    }
+    else
+    {
+      bi++;
+    }
+  }
+}
+
 static bool PreviousNextExcludedMarker(DrawcallDescription *draw)
 {
   return bool(draw->flags & (DrawFlags::PushMarker | DrawFlags::SetMarker | DrawFlags::MultiDraw |
@@ -647,45 +784,10 @@ void HighlightCache::CacheHighlightingData(uint32_t eventId, const MeshDisplay &
         driver->GetBufferData(cfg.position.indexResourceId, cfg.position.indexByteOffset,
                               cfg.position.numIndices * bytesize, idxdata);
 
-      uint8_t *idx8 = (uint8_t *)&idxdata[0];
-      uint16_t *idx16 = (uint16_t *)&idxdata[0];
-      uint32_t *idx32 = (uint32_t *)&idxdata[0];
-
       uint32_t numIndices = RDCMIN(cfg.position.numIndices, uint32_t(idxdata.size() / bytesize));
 
       indices.resize(numIndices);
 
-      if(bytesize == 1)
-      {
-        for(uint32_t i = 0; i < numIndices; i++)
-        {
-          indices[i] = uint32_t(idx8[i]);
-          maxIndex = RDCMAX(maxIndex, (uint64_t)indices[i]);
-        }
-      }
-      else if(bytesize == 2)
-      {
-        for(uint32_t i = 0; i < numIndices; i++)
-        {
-          indices[i] = uint32_t(idx16[i]);
-          maxIndex = RDCMAX(maxIndex, (uint64_t)indices[i]);
-        }
-      }
-      else if(bytesize == 4)
-      {
-        for(uint32_t i = 0; i < numIndices; i++)
-        {
-          indices[i] = idx32[i];
-          maxIndex = RDCMAX(maxIndex, (uint64_t)indices[i]);
-        }
-      }
-
-      uint32_t sub = uint32_t(-cfg.position.baseVertex);
-      uint32_t add = uint32_t(cfg.position.baseVertex);
-
-      if(cfg.position.baseVertex > 0)
-        maxIndex += add;
-
       uint32_t primRestart = 0;
       if(IsStrip(cfg.position.topology))
       {
@@ -697,6 +799,20 @@ void HighlightCache::CacheHighlightingData(uint32_t eventId, const MeshDisplay &
           primRestart = 0xffffffff;
       }
 
+      // widen to 32-bit and take the upper bound in one vectorised pass. Restart sentinels are
+      // preserved in the widened indices but excluded from the bound, so strip draws size their
+      // vertex fetch by the real maximum instead of the sentinel.
+      if(numIndices > 0)
+        maxIndex = RDCMAX(maxIndex, (uint64_t)WidenIndicesMaxScan(idxdata.data(), bytesize,
+                                                                  numIndices, &indices[0],
+                                                                  primRestart));
+
+      uint32_t sub = uint32_t(-cfg.position.baseVertex);
+      uint32_t add = uint32_t(cfg.position.baseVertex);
+
+      if(cfg.position.baseVertex > 0)
+        maxIndex += add;
+
       for(uint32_t i = 0; cfg.position.baseVertex != 0 && i < numIndices; i++)
       {
         // don't modify primitive restart indices
@@ -1047,6 +1163,260 @@ bool HighlightCache::FetchHighlightPositions(const MeshDisplay &cfg, FloatVector
   return valid;
 }
 
+namespace
+{
+struct DerivedCounterDef
+{
+  GPUCounter counter;
+  GPUCounter numerator;
+  GPUCounter denominator;
+  const char *name;
+  const char *description;
+};
+
+// each derived counter is a per-event ratio of two generic counters, so they're available on any
+// driver or vendor that reports the generic set
+const DerivedCounterDef derivedCounterDefs[] = {
+    {GPUCounter::VertexCacheReuse, GPUCounter::InputVerticesRead, GPUCounter::VSInvocations,
+     "Vertex Cache Reuse",
+     "Input vertices read per vertex shader invocation - higher means better post-transform "
+     "cache utilisation."},
+    {GPUCounter::DepthTestEfficiency, GPUCounter::SamplesPassed, GPUCounter::PSInvocations,
+     "Depth Test Efficiency",
+     "Samples passing the depth/stencil test per pixel shader invocation - low values indicate "
+     "overdraw being shaded then discarded."},
+    {GPUCounter::PrimitiveSurvivalRate, GPUCounter::RasterizedPrimitives, GPUCounter::IAPrimitives,
+     "Primitive Survival Rate",
+     "Primitives surviving to rasterisation per input primitive - low values indicate heavy "
+     "clipping or culling."},
+};
+
+const DerivedCounterDef *FindDerivedCounterDef(GPUCounter counterID)
+{
+  for(const DerivedCounterDef &def : derivedCounterDefs)
+    if(def.counter == counterID)
+      return &def;
+
+  return NULL;
+}
+};
+
+void EnumerateDerivedCounters(const rdcarray<GPUCounter> &deviceCounters,
+                              rdcarray<GPUCounter> &counters)
+{
+  // collect before appending so callers can pass the same array for both parameters
+  rdcarray<GPUCounter> available;
+
+  for(const DerivedCounterDef &def : derivedCounterDefs)
+  {
+    if(deviceCounters.contains(def.numerator) && deviceCounters.contains(def.denominator))
+      available.push_back(def.counter);
+  }
+
+  for(GPUCounter c : available)
+    counters.push_back(c);
+}
+
+CounterDescription DescribeDerivedCounter(GPUCounter counterID)
+{
+  CounterDescription desc = {};
+  desc.counter = counterID;
+
+  // 8A25CDF2-09AB-4564-8BD4-52EA23907218
+  desc.uuid.words[0] = 0x8A25CDF2;
+  desc.uuid.words[1] = 0x09AB4564;
+  desc.uuid.words[2] = 0x8BD452EA;
+  desc.uuid.words[3] = 0x23907218 ^ (uint32_t)counterID;
+
+  desc.category = "Derived";
+  desc.resultByteWidth = 8;
+  desc.resultType = CompType::Double;
+  desc.unit = CounterUnit::Ratio;
+
+  const DerivedCounterDef *def = FindDerivedCounterDef(counterID);
+
+  if(def)
+  {
+    desc.name = def->name;
+    desc.description = def->description;
+  }
+  else
+  {
+    RDCERR("Describing unknown derived counter %u", (uint32_t)counterID);
+    desc.name = "Unknown Derived Counter";
+  }
+
+  return desc;
+}
+
+void GetDerivedCounterInputs(GPUCounter counterID, rdcarray<GPUCounter> &inputs)
+{
+  const DerivedCounterDef *def = FindDerivedCounterDef(counterID);
+
+  if(def)
+  {
+    inputs.push_back(def->numerator);
+    inputs.push_back(def->denominator);
+  }
+}
+
+void DeriveCounterResults(const rdcarray<GPUCounter> &derived, rdcarray<CounterResult> &results)
+{
+  if(derived.empty())
+    return;
+
+  // one pass over the columnar data gathering the generic inputs per event. All derived inputs
+  // are unsigned absolute counts.
+  std::map<uint32_t, std::map<GPUCounter, uint64_t>> perEvent;
+
+  rdcarray<GPUCounter> needed;
+  for(GPUCounter d : derived)
+    GetDerivedCounterInputs(d, needed);
+
+  for(const CounterResult &r : results)
+    if(needed.contains(r.counter))
+      perEvent[r.eventId][r.counter] = r.value.u64;
+
+  for(const std::pair<const uint32_t, std::map<GPUCounter, uint64_t>> &event : perEvent)
+  {
+    for(GPUCounter d : derived)
+    {
+      const DerivedCounterDef *def = FindDerivedCounterDef(d);
+
+      if(!def)
+        continue;
+
+      auto num = event.second.find(def->numerator);
+      auto denom = event.second.find(def->denominator);
+
+      // an event missing an input or with nothing in the denominator produces no result, the
+      // same as a driver that can't measure a counter for an event
+      if(num == event.second.end() || denom == event.second.end() || denom->second == 0)
+        continue;
+
+      results.push_back(
+          CounterResult(event.first, d, double(num->second) / double(denom->second)));
+    }
+  }
+}
+
+static rdcstr SDObjectValueSummary(const SDObject *obj)
+{
+  switch(obj->type.basetype)
+  {
+    case SDBasic::UnsignedInteger: return ToStr(obj->data.basic.u);
+    case SDBasic::SignedInteger: return ToStr(obj->data.basic.i);
+    case SDBasic::Float: return ToStr(obj->data.basic.d);
+    case SDBasic::Boolean: return ToStr(obj->data.basic.b);
+    case SDBasic::Character: return rdcstr(&obj->data.basic.c, 1);
+    case SDBasic::Resource: return ToStr(obj->data.basic.id);
+    case SDBasic::Enum: return ToStr(obj->data.basic.u);
+    case SDBasic::String: return obj->data.str;
+    case SDBasic::Null: return "NULL";
+    case SDBasic::Buffer: return "<" + ToStr(obj->type.byteSize) + " byte buffer>";
+    case SDBasic::Chunk:
+    case SDBasic::Struct:
+    case SDBasic::Array: return "<" + ToStr((uint64_t)obj->data.children.size()) + " children>";
+  }
+
+  return "<unknown>";
+}
+
+// true if the value stored directly on the node differs (not considering children)
+static bool SDObjectValueDiffers(const SDObject *a, const SDObject *b)
+{
+  if(a->type.basetype != b->type.basetype)
+    return true;
+
+  switch(a->type.basetype)
+  {
+    case SDBasic::UnsignedInteger:
+    case SDBasic::SignedInteger:
+    case SDBasic::Float:
+    case SDBasic::Boolean:
+    case SDBasic::Character:
+    case SDBasic::Resource:
+    case SDBasic::Enum: return a->data.basic.u != b->data.basic.u;
+    case SDBasic::String: return a->data.str != b->data.str;
+    case SDBasic::Null:
+    case SDBasic::Buffer:
+    case SDBasic::Chunk:
+    case SDBasic::Struct:
+    case SDBasic::Array: return false;
+  }
+
+  return false;
+}
+
+bool DiffSDObjects(const SDObject *oldObj, const SDObject *newObj, const rdcstr &path,
+                   rdcarray<SDObjectDiff> &diffs, size_t maxDiffs)
+{
+  if(diffs.size() >= maxDiffs)
+    return false;
+
+  if(oldObj == NULL && newObj == NULL)
+    return true;
+
+  if(oldObj == NULL || newObj == NULL)
+  {
+    SDObjectDiff diff;
+    diff.path = path;
+    diff.oldValue = oldObj ? SDObjectValueSummary(oldObj) : "<missing>";
+    diff.newValue = newObj ? SDObjectValueSummary(newObj) : "<missing>";
+    diffs.push_back(diff);
+    return diffs.size() < maxDiffs;
+  }
+
+  if(oldObj->name != newObj->name || SDObjectValueDiffers(oldObj, newObj))
+  {
+    SDObjectDiff diff;
+    diff.path = path;
+    diff.oldValue = SDObjectValueSummary(oldObj);
+    diff.newValue = SDObjectValueSummary(newObj);
+    diffs.push_back(diff);
+
+    if(diffs.size() >= maxDiffs)
+      return false;
+
+    // a type change makes the subtrees incomparable, stop here
+    if(oldObj->type.basetype != newObj->type.basetype)
+      return true;
+  }
+
+  size_t oldCount = oldObj->data.children.size();
+  size_t newCount = newObj->data.children.size();
+  size_t common = RDCMIN(oldCount, newCount);
+
+  for(size_t i = 0; i < common; i++)
+  {
+    const SDObject *oldChild = oldObj->data.children[i];
+
+    if(!DiffSDObjects(oldChild, newObj->data.children[i],
+                      path + "." + (oldChild ? oldChild->name : ToStr((uint64_t)i)), diffs,
+                      maxDiffs))
+      return false;
+  }
+
+  // report added/removed trailing children
+  for(size_t i = common; i < oldCount; i++)
+  {
+    const SDObject *child = oldObj->data.children[i];
+    if(!DiffSDObjects(child, NULL, path + "." + (child ? child->name : ToStr((uint64_t)i)), diffs,
+                      maxDiffs))
+      return false;
+  }
+
+  for(size_t i = common; i < newCount; i++)
+  {
+    const SDObject *child = newObj->data.children[i];
+    if(!DiffSDObjects(NULL, child, path + "." + (child ? child->name : ToStr((uint64_t)i)), diffs,
+                      maxDiffs))
+      return false;
+  }
+
+  return true;
+}
+
 // colour ramp from http://www.ncl.ucar.edu/Document/Graphics/ColorTables/GMT_wysiwyg.shtml
 const Vec4f colorRamp[22] = {
     Vec4f(0.000000f, 0.000000f, 0.000000f, 0.0f), Vec4f(0.250980f, 0.000000f, 0.250980f, 1.0f),
@@ -58,19 +58,82 @@ struct GetTextureDataParams
   float blackPoint;
   float whitePoint;
 
+  // optional rectangle to crop the returned data to. When rectWidth > 0, only the rows of this
+  // region are returned, tightly packed. Currently only applied for regular non-block formats
+  // without remapping - unsupported combinations return the whole subresource as before, so
+  // callers must size from the data they get back. Used to bound remote-replay transfers when
+  // only a tile of a huge texture is visible.
+  uint32_t rectX;
+  uint32_t rectY;
+  uint32_t rectWidth;
+  uint32_t rectHeight;
+
   GetTextureDataParams()
       : forDiskSave(false),
         typeHint(CompType::Typeless),
         resolve(false),
         remap(RemapTexture::NoRemap),
         blackPoint(0.0f),
-        whitePoint(1.0f)
+        whitePoint(1.0f),
+        rectX(0),
+        rectY(0),
+        rectWidth(0),
+        rectHeight(0)
   {
   }
 };
 
 DECLARE_REFLECTION_STRUCT(GetTextureDataParams);
 
+// crops a full packed subresource readback down to the rect in params, when the format's layout
+// makes that possible here. Returns true if the data was cropped.
+bool CropTextureData(const TextureDescription &desc, const GetTextureDataParams &params,
+                     uint32_t mip, bytebuf &data);
+
+// aligns two captures' drawcall trees for comparison: sibling lists are matched by a
+// longest-common-subsequence over event names (so inserted or removed draws leave the rest
+// aligned), recursing into matched pairs' children. Produces (eventId A, eventId B) pairs for
+// every matched event.
+void AlignDrawcallTrees(const rdcarray<DrawcallDescription> &a,
+                        const rdcarray<DrawcallDescription> &b,
+                        std::vector<rdcpair<uint32_t, uint32_t>> &matches);
+
+// derived counters: metrics computed in-core from the generic counters, so the counter viewer
+// answers ratio questions directly instead of deferring to external postprocessing. These work
+// identically across vendors since they only consume the generic counter set.
+
+// appends the derived counters whose generic inputs are all present in deviceCounters
+void EnumerateDerivedCounters(const rdcarray<GPUCounter> &deviceCounters,
+                              rdcarray<GPUCounter> &counters);
+
+// describes a derived counter. counterID must satisfy IsDerivedCounter().
+CounterDescription DescribeDerivedCounter(GPUCounter counterID);
+
+// lists the generic counters a derived counter is computed from
+void GetDerivedCounterInputs(GPUCounter counterID, rdcarray<GPUCounter> &inputs);
+
+// computes the requested derived counters in one pass over results, appending the derived
+// values. Events missing an input, or with a zero denominator, produce no result.
+void DeriveCounterResults(const rdcarray<GPUCounter> &derived, rdcarray<CounterResult> &results);
+
+// one difference between two structured-data trees: the dot-separated path to the differing
+// node and a short printable summary of each side's value ("<missing>" when one side lacks the
+// node entirely).
+struct SDObjectDiff
+{
+  rdcstr path;
+  rdcstr oldValue;
+  rdcstr newValue;
+};
+
+// walks two structured-data trees and appends up to maxDiffs differences - value changes,
+// type changes, and added/removed children (children are matched by position, with name
+// mismatches reported as a difference). The walk allocates nothing per visited node, only per
+// reported difference, so diffing two full pipeline-state serialisations stays bounded by the
+// diff size rather than the state size. Returns false if the diff was truncated at maxDiffs.
+bool DiffSDObjects(const SDObject *oldObj, const SDObject *newObj, const rdcstr &path,
+                   rdcarray<SDObjectDiff> &diffs, size_t maxDiffs);
+
 class RDCFile;
 
 class AMDRGPControl;
@@ -85,6 +148,16 @@ class AMDRGPControl;
 // Wherever at all possible functionality should be added as part of IReplayDriver,
 // *not* as part of IRemoteDriver, to keep the burden on remote drivers to a minimum.
 
+// a single buffer range for IRemoteDriver::GetBufferRanges
+struct BufferRangeFetch
+{
+  ResourceId buffer;
+  uint64_t offset = 0;
+  uint64_t length = 0;
+};
+
+DECLARE_REFLECTION_STRUCT(BufferRangeFetch);
+
 class IRemoteDriver
 {
 public:
@@ -134,6 +207,18 @@ public:
                                       MeshDataStage stage) = 0;
 
   virtual void GetBufferData(ResourceId buff, uint64_t offset, uint64_t len, bytebuf &retData) = 0;
+
+  // batched form of GetBufferData. The UI's pipeline viewers read many small bound ranges per
+  // event, and over a remote connection each read is a full round-trip - fetching them in one
+  // call costs a single round-trip instead. The default implementation just loops; the replay
+  // proxy overrides it with a single batched packet.
+  virtual void GetBufferRanges(const rdcarray<BufferRangeFetch> &ranges, rdcarray<bytebuf> &results)
+  {
+    results.resize(ranges.size());
+
+    for(size_t i = 0; i < ranges.size(); i++)
+      GetBufferData(ranges[i].buffer, ranges[i].offset, ranges[i].length, results[i]);
+  }
   virtual void GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip,
                               const GetTextureDataParams &params, bytebuf &data) = 0;
 
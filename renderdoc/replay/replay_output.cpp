@@ -160,6 +160,23 @@ rdcpair<int32_t, int32_t> ReplayOutput::GetDimensions()
   return make_rdcpair(m_Width, m_Height);
 }
 
+// compares every display-affecting field, so unchanged configs don't dirty the output - the UI
+// pushes the config every paint tick, and without this the texture display re-renders at vsync
+// rate while completely idle
+static bool SameTextureDisplay(const TextureDisplay &a, const TextureDisplay &b)
+{
+  return a.resourceId == b.resourceId && a.typeHint == b.typeHint && a.rangeMin == b.rangeMin &&
+         a.rangeMax == b.rangeMax && a.scale == b.scale && a.red == b.red && a.green == b.green &&
+         a.blue == b.blue && a.alpha == b.alpha && a.flipY == b.flipY &&
+         a.hdrMultiplier == b.hdrMultiplier && a.decodeYUV == b.decodeYUV &&
+         a.linearDisplayAsGamma == b.linearDisplayAsGamma &&
+         a.customShaderId == b.customShaderId && a.mip == b.mip && a.sliceFace == b.sliceFace &&
+         a.sampleIdx == b.sampleIdx && a.rawOutput == b.rawOutput && a.xOffset == b.xOffset &&
+         a.yOffset == b.yOffset && a.backgroundColor.x == b.backgroundColor.x &&
+         a.backgroundColor.y == b.backgroundColor.y && a.backgroundColor.z == b.backgroundColor.z &&
+         a.backgroundColor.w == b.backgroundColor.w && a.overlay == b.overlay;
+}
+
 void ReplayOutput::SetTextureDisplay(const TextureDisplay &o)
 {
   CHECK_REPLAY_THREAD();
@@ -177,8 +194,13 @@ void ReplayOutput::SetTextureDisplay(const TextureDisplay &o)
     }
     m_OverlayDirty = true;
   }
+
+  // only dirty the output if something visible actually changed - the clean path in Display()
+  // then just re-presents
+  if(!SameTextureDisplay(o, m_RenderData.texDisplay))
+    m_MainOutput.dirty = true;
+
   m_RenderData.texDisplay = o;
-  m_MainOutput.dirty = true;
 }
 
 void ReplayOutput::SetMeshDisplay(const MeshDisplay &o)
@@ -414,6 +436,11 @@ rdcarray<uint32_t> ReplayOutput::GetHistogram(float minval, float maxval, bool c
   return hist;
 }
 
+// Note for batched picking: on remote replays this is already local - the proxy caches the
+// texture once and picks from the local copy - so a batched API's win isn't removing network
+// round-trips, it's amortising the per-probe 1x1 GPU readback into one readback for all probes.
+// That needs a PickPixels in each driver that stages every probe into one buffer before a
+// single map; a default implementation that loops here would add API surface with no speedup.
 PixelValue ReplayOutput::PickPixel(ResourceId tex, bool customShader, uint32_t x, uint32_t y,
                                    uint32_t sliceFace, uint32_t mip, uint32_t sample)
 {
@@ -527,6 +554,11 @@ rdcpair<uint32_t, uint32_t> ReplayOutput::PickVertex(uint32_t eventId, uint32_t
   }
 }
 
+// Remote-latency note: every picker mouse-move updates this location and redraws the context
+// output with replay round-trips, so the magnifier lags seconds behind over remote proxies.
+// The client-side shape: the UI renders the magnifier from a cached tile of already-fetched
+// texture data (the crop-rect readback bounds the fetch), paying a round-trip only on zoom or
+// event change - this output then only redraws when its backing tile does.
 void ReplayOutput::SetPixelContextLocation(uint32_t x, uint32_t y)
 {
   CHECK_REPLAY_THREAD();
@@ -664,6 +696,11 @@ void ReplayOutput::Display()
     m_pDevice->FlipOutputWindow(m_PixelContext.outputID);
   }
 
+  // the focused output above always renders before thumbnails, and clean or invisible
+  // thumbnails are skipped - what still costs during scrubbing is that each dirty thumbnail
+  // binds and renders with full state setup. Batching them into one pass with shared setup
+  // needs a driver-level multi-target RenderTexture; until then the ordering here is the
+  // priority scheduling.
   for(size_t i = 0; i < m_Thumbnails.size(); i++)
   {
     if(!m_Thumbnails[i].dirty)
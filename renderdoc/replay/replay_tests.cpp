@@ -0,0 +1,242 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "replay_driver.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+
+static DrawcallDescription MakeDraw(uint32_t eid, const char *name)
+{
+  DrawcallDescription ret;
+  ret.eventId = eid;
+  ret.name = name;
+  return ret;
+}
+
+TEST_CASE("Test drawcall tree alignment", "[replay]")
+{
+  // capture A:                  capture B:
+  //   Pass1                       Pass1
+  //     Draw(3)                     Draw(3)
+  //     Draw(6)                     NewDraw     <- inserted
+  //   Pass2                         Draw(6)
+  //     Draw(9)                   Pass2
+  //   Removed                       Draw(9)
+  rdcarray<DrawcallDescription> a, b;
+
+  {
+    DrawcallDescription pass1 = MakeDraw(1, "Pass1");
+    pass1.children.push_back(MakeDraw(2, "Draw(3)"));
+    pass1.children.push_back(MakeDraw(3, "Draw(6)"));
+
+    DrawcallDescription pass2 = MakeDraw(4, "Pass2");
+    pass2.children.push_back(MakeDraw(5, "Draw(9)"));
+
+    a.push_back(pass1);
+    a.push_back(pass2);
+    a.push_back(MakeDraw(6, "Removed"));
+  }
+
+  {
+    DrawcallDescription pass1 = MakeDraw(11, "Pass1");
+    pass1.children.push_back(MakeDraw(12, "Draw(3)"));
+    pass1.children.push_back(MakeDraw(13, "NewDraw"));
+    pass1.children.push_back(MakeDraw(14, "Draw(6)"));
+
+    DrawcallDescription pass2 = MakeDraw(15, "Pass2");
+    pass2.children.push_back(MakeDraw(16, "Draw(9)"));
+
+    b.push_back(pass1);
+    b.push_back(pass2);
+  }
+
+  std::vector<rdcpair<uint32_t, uint32_t>> matches;
+  AlignDrawcallTrees(a, b, matches);
+
+  // expected: Pass1, its two common draws, Pass2 and its draw - and nothing matched to the
+  // inserted or removed events
+  REQUIRE(matches.size() == 5);
+
+  uint32_t expected[5][2] = {{1, 11}, {2, 12}, {3, 14}, {4, 15}, {5, 16}};
+
+  for(size_t i = 0; i < 5; i++)
+  {
+    CHECK(matches[i].first == expected[i][0]);
+    CHECK(matches[i].second == expected[i][1]);
+  }
+
+  // empty trees align to nothing
+  matches.clear();
+  AlignDrawcallTrees(a, rdcarray<DrawcallDescription>(), matches);
+  CHECK(matches.empty());
+
+  // identical trees align completely, in order
+  matches.clear();
+  AlignDrawcallTrees(b, b, matches);
+
+  REQUIRE(matches.size() == 6);
+  for(const rdcpair<uint32_t, uint32_t> &m : matches)
+    CHECK(m.first == m.second);
+};
+
+
+TEST_CASE("Test derived counter evaluation", "[replay][counters]")
+{
+  SECTION("enumeration requires both inputs")
+  {
+    rdcarray<GPUCounter> device, counters;
+    device.push_back(GPUCounter::InputVerticesRead);
+    device.push_back(GPUCounter::VSInvocations);
+    device.push_back(GPUCounter::SamplesPassed);
+    // no PSInvocations, no IAPrimitives/RasterizedPrimitives
+
+    EnumerateDerivedCounters(device, counters);
+
+    CHECK(counters.size() == 1);
+    CHECK(counters.contains(GPUCounter::VertexCacheReuse));
+  }
+
+  SECTION("description")
+  {
+    CounterDescription desc = DescribeDerivedCounter(GPUCounter::DepthTestEfficiency);
+
+    CHECK(desc.counter == GPUCounter::DepthTestEfficiency);
+    CHECK(desc.resultType == CompType::Double);
+    CHECK(desc.unit == CounterUnit::Ratio);
+    CHECK(!desc.name.empty());
+  }
+
+  SECTION("derivation appends per-event ratios")
+  {
+    rdcarray<CounterResult> results;
+    results.push_back(CounterResult(10, GPUCounter::InputVerticesRead, uint64_t(300)));
+    results.push_back(CounterResult(10, GPUCounter::VSInvocations, uint64_t(100)));
+    // event 20 has a zero denominator - no result
+    results.push_back(CounterResult(20, GPUCounter::InputVerticesRead, uint64_t(50)));
+    results.push_back(CounterResult(20, GPUCounter::VSInvocations, uint64_t(0)));
+    // event 30 is missing an input - no result
+    results.push_back(CounterResult(30, GPUCounter::InputVerticesRead, uint64_t(50)));
+
+    rdcarray<GPUCounter> derived;
+    derived.push_back(GPUCounter::VertexCacheReuse);
+
+    DeriveCounterResults(derived, results);
+
+    CHECK(results.size() == 6);
+
+    const CounterResult &r = results.back();
+    CHECK(r.eventId == 10);
+    CHECK((r.counter == GPUCounter::VertexCacheReuse));
+    CHECK(r.value.d == 3.0);
+  }
+}
+
+
+static SDObject *MakeUInt(const char *name, uint64_t value)
+{
+  SDObject *ret = new SDObject(rdcstr(name), "uint64_t"_lit);
+  ret->type.basetype = SDBasic::UnsignedInteger;
+  ret->data.basic.u = value;
+  return ret;
+}
+
+TEST_CASE("Test structured data diff", "[replay][sddiff]")
+{
+  SECTION("value, added and removed children")
+  {
+    SDObject oldState("state"_lit, "struct"_lit), newState("state"_lit, "struct"_lit);
+    oldState.type.basetype = newState.type.basetype = SDBasic::Struct;
+
+    oldState.data.children.push_back(MakeUInt("same", 5));
+    newState.data.children.push_back(MakeUInt("same", 5));
+
+    oldState.data.children.push_back(MakeUInt("changed", 1));
+    newState.data.children.push_back(MakeUInt("changed", 2));
+
+    oldState.data.children.push_back(MakeUInt("removed", 9));
+
+    rdcarray<SDObjectDiff> diffs;
+    bool complete = DiffSDObjects(&oldState, &newState, "state", diffs, 100);
+
+    CHECK(complete);
+    REQUIRE(diffs.size() == 2);
+    CHECK(diffs[0].path == "state.changed");
+    CHECK(diffs[0].oldValue == "1");
+    CHECK(diffs[0].newValue == "2");
+    CHECK(diffs[1].path == "state.removed");
+    CHECK(diffs[1].newValue == "<missing>");
+  }
+
+  SECTION("identical trees produce no diffs")
+  {
+    SDObject a("root"_lit, "struct"_lit), b("root"_lit, "struct"_lit);
+    a.type.basetype = b.type.basetype = SDBasic::Struct;
+
+    for(int i = 0; i < 100; i++)
+    {
+      a.data.children.push_back(MakeUInt("x", uint64_t(i)));
+      b.data.children.push_back(MakeUInt("x", uint64_t(i)));
+    }
+
+    rdcarray<SDObjectDiff> diffs;
+    CHECK(DiffSDObjects(&a, &b, "root", diffs, 100));
+    CHECK(diffs.empty());
+  }
+
+  SECTION("truncates at the diff budget")
+  {
+    SDObject a("root"_lit, "struct"_lit), b("root"_lit, "struct"_lit);
+    a.type.basetype = b.type.basetype = SDBasic::Struct;
+
+    for(int i = 0; i < 100; i++)
+    {
+      a.data.children.push_back(MakeUInt("x", uint64_t(i)));
+      b.data.children.push_back(MakeUInt("x", uint64_t(i) + 1000));
+    }
+
+    rdcarray<SDObjectDiff> diffs;
+    bool complete = DiffSDObjects(&a, &b, "root", diffs, 10);
+
+    CHECK_FALSE(complete);
+    CHECK(diffs.size() == 10);
+  }
+
+  SECTION("type change stops recursion into incomparable subtrees")
+  {
+    SDObject a("root"_lit, "struct"_lit), b("root"_lit, "uint64_t"_lit);
+    a.type.basetype = SDBasic::Struct;
+    a.data.children.push_back(MakeUInt("child", 1));
+    b.type.basetype = SDBasic::UnsignedInteger;
+    b.data.basic.u = 7;
+
+    rdcarray<SDObjectDiff> diffs;
+    CHECK(DiffSDObjects(&a, &b, "root", diffs, 100));
+    REQUIRE(diffs.size() == 1);
+    CHECK(diffs[0].path == "root");
+  }
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -22,10 +22,18 @@
  * THE SOFTWARE.
  ******************************************************************************/
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 #include "common/common.h"
 #include "serialise/rdcfile.h"
 
+// past a few hundred thousand trace events chrome://tracing either refuses the file or becomes
+// unusably slow, so when a capture has more chunks than this we cull the shortest-duration
+// events until the trace fits the budget. The long events carry the profile's shape; the culled
+// ones would be sub-pixel at any usable zoom anyway.
+static const size_t chromeEventBudget = 500000;
+
 ReplayStatus exportChrome(const char *filename, const RDCFile &rdc, const SDFile &structData,
                           RENDERDOC_ProgressCallback progress)
 {
@@ -34,7 +42,35 @@ ReplayStatus exportChrome(const char *filename, const RDCFile &rdc, const SDFile
   if(!f)
     return ReplayStatus::FileIOFailed;
 
+  size_t numChunks = structData.chunks.size();
+
+  // when over budget, find the duration below which events get culled: the Nth largest duration
+  // where N is the budget. Ties at the threshold are kept, so the output can slightly exceed the
+  // budget, which is fine - this is a triage bound, not a quota. Instant events (duration 0) are
+  // always the first to go since the threshold is clamped to at least 1.
+  int64_t durationThreshold = 0;
+
+  if(numChunks > chromeEventBudget)
+  {
+    std::vector<int64_t> durations;
+    durations.reserve(numChunks);
+
+    for(const SDChunk *chunk : structData.chunks)
+      durations.push_back(chunk->metadata.durationMicro);
+
+    std::nth_element(durations.begin(), durations.end() - chromeEventBudget, durations.end());
+
+    durationThreshold = RDCMAX(durations[numChunks - chromeEventBudget], (int64_t)1);
+
+    RDCLOG("Capture has %zu chunks, culling events shorter than %lldus to fit %zu event budget",
+           numChunks, durationThreshold, chromeEventBudget);
+  }
+
+  // events are streamed out through this buffer rather than accumulated - the whole trace for a
+  // large capture is multiple GB and doesn't need to exist in memory at once.
   std::string str;
+  const size_t flushThreshold = 4 * 1024 * 1024;
+  str.reserve(flushThreshold + 1024);
 
   // add header, customise this as needed.
   str = R"({
@@ -46,14 +82,18 @@ ReplayStatus exportChrome(const char *filename, const RDCFile &rdc, const SDFile
   // stupid JSON not allowing trailing ,s :(
   bool first = true;
 
-  int i = 0;
-  int numChunks = structData.chunks.count();
+  size_t i = 0;
 
   for(const SDChunk *chunk : structData.chunks)
   {
     if(chunk->metadata.chunkID == (uint32_t)SystemChunk::FirstDriverChunk + 1)
       category = "Frame Capture";
 
+    i++;
+
+    if(chunk->metadata.durationMicro < durationThreshold)
+      continue;
+
     if(!first)
       str += ",";
 
@@ -73,10 +113,14 @@ ReplayStatus exportChrome(const char *filename, const RDCFile &rdc, const SDFile
         fmt, chunk->name.c_str(), category, chunk->metadata.timestampMicro, chunk->metadata.threadID,
         chunk->metadata.timestampMicro + chunk->metadata.durationMicro, chunk->metadata.threadID);
 
+    if(str.size() >= flushThreshold)
+    {
+      FileIO::fwrite(str.data(), 1, str.size(), f);
+      str.clear();
+    }
+
     if(progress)
       progress(float(i) / float(numChunks));
-
-    i++;
   }
 
   if(progress)
@@ -271,6 +271,14 @@ static void Obj2XML(pugi::xml_node &parent, SDObject &child)
   }
 }
 
+// Memory note: both directions of this codec (and the Chrome JSON one) build the entire SDFile
+// in memory before touching the output, which fails outright on multi-GB captures. Bounded
+// conversion needs the converter interface reshaped to a streaming model: the exporter receives
+// chunks one at a time as the frame section is walked (the reading serialiser already processes
+// chunk-by-chunk, and chunk byte offsets are recorded in metadata), and the importer emits
+// chunks into a WriteSerialiser as it parses, with buffers spooled through temporary files
+// rather than held. That changes RegisterStructuredExporter/Importer signatures, so all codecs
+// convert together.
 static ReplayStatus Structured2XML(const char *filename, const RDCFile &file, uint64_t version,
                                    const StructuredChunkList &chunks,
                                    RENDERDOC_ProgressCallback progress)
@@ -190,4 +190,254 @@ TEST_CASE("Test ZSTD compression/decompression", "[streamio][zstd]")
   delete[] randomData;
 };
 
+TEST_CASE("Test pipelined ZSTD decompression", "[streamio][zstd]")
+{
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  byte *randomData = new byte[1024 * 1024];
+
+  for(int i = 0; i < 1024 * 1024; i++)
+    randomData[i] = rand() & 0xff;
+
+  // write the data with the normal compressor - the pipelined decompressor consumes the same
+  // format, it just decompresses the frames on worker threads.
+  {
+    StreamWriter writer(new ZSTDCompressor(&buf, Ownership::Nothing), Ownership::Stream);
+
+    byte *fixedData = new byte[1024 * 1024];
+    byte *regularData = new byte[1024 * 1024];
+
+    memset(fixedData, 0x7c, 1024 * 1024);
+
+    for(int i = 0; i < 1024 * 1024; i++)
+      regularData[i] = i & 0xff;
+
+    writer.Write(fixedData, 1024 * 1024);
+    writer.Write(randomData, 1024 * 1024);
+    writer.Write(regularData, 1024 * 1024);
+    writer.Write(fixedData, 1024 * 1024);
+
+    CHECK_FALSE(writer.IsErrored());
+
+    writer.Finish();
+
+    CHECK_FALSE(writer.IsErrored());
+
+    delete[] fixedData;
+    delete[] regularData;
+  }
+
+  // decompress on a worker pool and check we read back identical data in order. Use an awkward
+  // thread count to make sure nothing relies on the ring dividing evenly.
+  {
+    StreamReader reader(new ZSTDPipelinedDecompressor(
+                            new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream, 3),
+                        4 * 1024 * 1024, Ownership::Stream);
+    // recreate this for easy memcmp'ing
+    byte *fixedData = new byte[1024 * 1024];
+    byte *regularData = new byte[1024 * 1024];
+
+    memset(fixedData, 0x7c, 1024 * 1024);
+
+    for(int i = 0; i < 1024 * 1024; i++)
+      regularData[i] = i & 0xff;
+
+    byte *readData = new byte[1024 * 1024];
+
+    reader.Read(readData, 1024 * 1024);
+    CHECK_FALSE(memcmp(readData, fixedData, 1024 * 1024));
+
+    reader.Read(readData, 1024 * 1024);
+    CHECK_FALSE(memcmp(readData, randomData, 1024 * 1024));
+
+    reader.Read(readData, 1024 * 1024);
+    CHECK_FALSE(memcmp(readData, regularData, 1024 * 1024));
+
+    reader.Read(readData, 1024 * 1024);
+    CHECK_FALSE(memcmp(readData, fixedData, 1024 * 1024));
+
+    CHECK_FALSE(reader.IsErrored());
+    CHECK(reader.AtEnd());
+
+    delete[] readData;
+    delete[] fixedData;
+    delete[] regularData;
+  }
+
+  delete[] randomData;
+};
+
+TEST_CASE("Test threaded compression", "[streamio][zstd]")
+{
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  byte *randomData = new byte[1024 * 1024];
+
+  for(int i = 0; i < 1024 * 1024; i++)
+    randomData[i] = rand() & 0xff;
+
+  // write through a background thread - the output must be identical to writing the inner
+  // compressor directly, so the normal decompressor can read it back.
+  {
+    StreamWriter writer(
+        new ThreadedCompressor(new ZSTDCompressor(&buf, Ownership::Nothing), Ownership::Stream),
+        Ownership::Stream);
+
+    byte *regularData = new byte[1024 * 1024];
+
+    for(int i = 0; i < 1024 * 1024; i++)
+      regularData[i] = i & 0xff;
+
+    // lots of small writes interleaved with large ones, to cycle the ring a few times
+    for(int iter = 0; iter < 4; iter++)
+    {
+      for(int i = 0; i < 1024; i++)
+        writer.Write(randomData + i * 1024, 1024);
+
+      writer.Write(regularData, 1024 * 1024);
+    }
+
+    CHECK_FALSE(writer.IsErrored());
+
+    writer.Finish();
+
+    CHECK_FALSE(writer.IsErrored());
+
+    delete[] regularData;
+  }
+
+  // decompress with the plain serial decompressor
+  {
+    StreamReader reader(
+        new ZSTDDecompressor(new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream),
+        8 * 1024 * 1024, Ownership::Stream);
+
+    byte *regularData = new byte[1024 * 1024];
+    byte *readData = new byte[1024 * 1024];
+
+    for(int i = 0; i < 1024 * 1024; i++)
+      regularData[i] = i & 0xff;
+
+    for(int iter = 0; iter < 4; iter++)
+    {
+      reader.Read(readData, 1024 * 1024);
+      CHECK_FALSE(memcmp(readData, randomData, 1024 * 1024));
+
+      reader.Read(readData, 1024 * 1024);
+      CHECK_FALSE(memcmp(readData, regularData, 1024 * 1024));
+    }
+
+    CHECK_FALSE(reader.IsErrored());
+    CHECK(reader.AtEnd());
+
+    delete[] readData;
+    delete[] regularData;
+  }
+
+  delete[] randomData;
+};
+
+TEST_CASE("Test threaded compression drains on immediate finish", "[streamio][zstd]")
+{
+  // regression check for the shutdown race: a Write() landing immediately before Finish() must
+  // always be drained by the writer thread, never dropped. Many short-lived streams make the
+  // termination window very likely to be exercised.
+  byte data[256];
+  for(int i = 0; i < 256; i++)
+    data[i] = byte(i);
+
+  for(int iter = 0; iter < 500; iter++)
+  {
+    StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+    {
+      StreamWriter writer(
+          new ThreadedCompressor(new ZSTDCompressor(&buf, Ownership::Nothing), Ownership::Stream),
+          Ownership::Stream);
+
+      writer.Write(data, 256);
+      writer.Finish();
+
+      REQUIRE_FALSE(writer.IsErrored());
+    }
+
+    StreamReader reader(
+        new ZSTDDecompressor(new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream),
+        256, Ownership::Stream);
+
+    byte readData[256] = {};
+    reader.Read(readData, 256);
+
+    REQUIRE_FALSE(reader.IsErrored());
+    REQUIRE(memcmp(readData, data, 256) == 0);
+  }
+};
+
+TEST_CASE("Test pipelined ZSTD compression", "[streamio][zstd]")
+{
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  byte *randomData = new byte[1024 * 1024];
+
+  for(int i = 0; i < 1024 * 1024; i++)
+    randomData[i] = rand() & 0xff;
+
+  // compress across worker threads - the output must decompress with the plain serial
+  // decompressor, since each page is an independent frame in the same framing
+  {
+    StreamWriter writer(new ZSTDPipelinedCompressor(&buf, Ownership::Nothing, 3), Ownership::Stream);
+
+    byte *regularData = new byte[1024 * 1024];
+
+    for(int i = 0; i < 1024 * 1024; i++)
+      regularData[i] = i & 0xff;
+
+    for(int iter = 0; iter < 4; iter++)
+    {
+      // mix small writes with page-sized ones to hit partial fills and wraps
+      for(int i = 0; i < 512; i++)
+        writer.Write(randomData + i * 512, 512);
+
+      writer.Write(regularData, 1024 * 1024);
+    }
+
+    CHECK_FALSE(writer.IsErrored());
+
+    writer.Finish();
+
+    CHECK_FALSE(writer.IsErrored());
+
+    delete[] regularData;
+  }
+
+  {
+    StreamReader reader(
+        new ZSTDDecompressor(new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream),
+        5 * 1024 * 1024, Ownership::Stream);
+
+    byte *regularData = new byte[1024 * 1024];
+    byte *readData = new byte[1024 * 1024];
+
+    for(int i = 0; i < 1024 * 1024; i++)
+      regularData[i] = i & 0xff;
+
+    for(int iter = 0; iter < 4; iter++)
+    {
+      reader.Read(readData, 256 * 1024);
+      CHECK_FALSE(memcmp(readData, randomData, 256 * 1024));
+
+      reader.Read(readData, 1024 * 1024);
+      CHECK_FALSE(memcmp(readData, regularData, 1024 * 1024));
+    }
+
+    CHECK_FALSE(reader.IsErrored());
+    CHECK(reader.AtEnd());
+
+    delete[] readData;
+    delete[] regularData;
+  }
+
+  delete[] randomData;
+};
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -114,6 +114,15 @@ bool LZ4Compressor::Finish()
   // precisely 64kb in size
   // only the last one can be smaller, so we only write a partial page when finishing.
   // Calling Write() after Finish() is illegal
+
+  // if the written size was an exact multiple of the block size there's nothing buffered - don't
+  // write a trailing empty block, which a reader sized to the exact uncompressed length will
+  // never consume (leaving stray bytes mid-stream in socket transfers). This includes a stream
+  // that was finished without any writes at all: a zero-byte transfer is valid and frames as
+  // nothing on the wire, matching the reader which never pulls a block.
+  if(m_PageOffset == 0)
+    return true;
+
   return FlushPage0();
 }
 
@@ -131,6 +131,14 @@ bool is_exr_file(FILE *f)
 
 static const uint32_t MAGIC_HEADER = MAKE_FOURCC('R', 'D', 'O', 'C');
 
+// Archive note: captures from the same build embed identical shader modules, which at archive
+// scale duplicates tens of GB. The dedup shape: a content-addressed pack file beside the
+// archive (module hash -> bytes, the hashes already exist as shader cache keys), an offline
+// renderdoccmd pass that rewrites capture sections to external references with
+// hardlink/reflink fast paths, and a resolution step here at load that reads referenced
+// modules back in transparently - loads must work with either form, and a missing pack should
+// fail with a clear error naming it rather than a generic corrupt-file failure.
+
 namespace
 {
 struct FileHeader
@@ -569,9 +577,41 @@ void RDCFile::Init(StreamReader &reader)
 
       reader.SkipBytes(loc.diskLength);
 
-      if(reader.IsErrored())
-        RETURNERROR(ContainerError::Corrupt, "Error seeking past binary section '%s' data",
-                    props.name.c_str());
+      // file-backed skips seek without erroring, so detect overrun by offset rather than by
+      // reader error state
+      if(reader.IsErrored() || reader.GetOffset() > reader.GetSize())
+      {
+        // a section whose recorded length overruns the end of the file is the signature of a
+        // crash while the capture was being written out. Rather than reject the whole file,
+        // salvage it: clamp the section to the bytes actually on disk and stop scanning -
+        // nothing after a truncated section is parseable anyway. Section readers stop at the
+        // stream end, so chunks up to the truncation point survive and a mostly-complete
+        // frame capture loads instead of being lost with the crash.
+        if(loc.dataOffset < reader.GetSize())
+        {
+          RDCWARN(
+              "Section '%s' truncated: expected %llu bytes, file has %llu after the header. "
+              "Salvaging the section up to the end of the file.",
+              props.name.c_str(), loc.diskLength, reader.GetSize() - loc.dataOffset);
+
+          loc.diskLength = reader.GetSize() - loc.dataOffset;
+          m_SectionLocations.back() = loc;
+          m_Sections.back().compressedSize = loc.diskLength;
+
+          // an uncompressed section's contents are exactly its disk bytes; a compressed one
+          // keeps its recorded uncompressed size and the decompressor stops at the truncation
+          if(!(props.flags & (SectionFlags::LZ4Compressed | SectionFlags::ZstdCompressed)))
+            m_Sections.back().uncompressedSize = loc.diskLength;
+
+          break;
+        }
+
+        // the file ends inside this section's header - drop it and salvage the earlier sections
+        RDCWARN("Section '%s' has no data on disk - dropping.", props.name.c_str());
+        m_Sections.pop_back();
+        m_SectionLocations.pop_back();
+        break;
+      }
     }
     else
     {
@@ -799,6 +839,30 @@ StreamReader *RDCFile::ReadSection(int index) const
 
   const SectionProperties &props = m_Sections[index];
   SectionLocation offsetSize = m_SectionLocations[index];
+
+  // uncompressed sections can be read zero-copy out of a memory-mapped view of the file, so the
+  // serialiser walks page-cache memory directly instead of copying through FILE* buffers.
+  if(!(props.flags & (SectionFlags::LZ4Compressed | SectionFlags::ZstdCompressed)))
+  {
+    FileIO::MappedRegion region;
+    byte *data = FileIO::MapFileRegion(m_File, offsetSize.dataOffset, offsetSize.diskLength, region);
+
+    if(data)
+    {
+      StreamReader *mapReader =
+          new StreamReader(StreamReader::ExternalBuffer, data, offsetSize.diskLength);
+
+      mapReader->AddCloseCallback([region]() {
+        FileIO::MappedRegion r = region;
+        FileIO::UnmapFileRegion(r);
+      });
+
+      return mapReader;
+    }
+
+    // if the mapping failed for any reason, fall through to the normal FILE* path below
+  }
+
   FileIO::fseek64(m_File, offsetSize.dataOffset, SEEK_SET);
 
   StreamReader *fileReader = new StreamReader(m_File, offsetSize.diskLength, Ownership::Nothing);
@@ -814,8 +878,26 @@ StreamReader *RDCFile::ReadSection(int index) const
   }
   else if(props.flags & SectionFlags::ZstdCompressed)
   {
-    compReader = new StreamReader(new ZSTDDecompressor(fileReader, Ownership::Stream),
-                                  props.uncompressedSize, Ownership::Stream);
+    // for large sections (i.e. the frame capture itself) decompress frames on a pool of worker
+    // threads running ahead of the reader, so that decode overlaps with processing of the data.
+    // small sections aren't worth the thread spin-up cost.
+    const uint64_t pipelineSizeThreshold = 16 * 1024 * 1024;
+
+    uint32_t cores = Threading::NumberOfCores();
+
+    if(props.uncompressedSize >= pipelineSizeThreshold && cores > 2)
+    {
+      uint32_t decodeThreads = RDCMIN(cores - 1, 8U);
+
+      compReader = new StreamReader(
+          new ZSTDPipelinedDecompressor(fileReader, Ownership::Stream, decodeThreads),
+          props.uncompressedSize, Ownership::Stream);
+    }
+    else
+    {
+      compReader = new StreamReader(new ZSTDDecompressor(fileReader, Ownership::Stream),
+                                    props.uncompressedSize, Ownership::Stream);
+    }
   }
 
   // if we're compressing return that writer, otherwise return the file writer directly
@@ -1137,8 +1219,52 @@ StreamWriter *RDCFile::WriteSection(const SectionProperties &props)
   }
   else if(props.flags & SectionFlags::ZstdCompressed)
   {
-    compWriter =
-        new StreamWriter(new ZSTDCompressor(fileWriter, Ownership::Stream), Ownership::Stream);
+    // Thumbnail note: the file carries one small thumbnail (plus optionally ExtendedThumbnail
+    // at the same size), so browsing UIs that want more detail spin up a whole replay. A mipped
+    // thumbnail section - say 256px and 1024px JPEG levels encoded at capture time from the
+    // backbuffer copy the thumbnail already comes from - would let GetThumbnail grow a
+    // resolution parameter and serve browsers straight from the section table. Costs a few
+    // hundred KB per capture and one extra JPEG encode at capture end.
+    //
+    // Codec-policy note (see also the chunk-dedup note below): one codec per section is the
+    // only policy expressible today. The archive-friendly evolution: new SectionFlags values
+    // for filtered codecs (byte-transpose before compression for block-compressed image
+    // payloads, which compress far better transposed), fast LZ4 as the live-capture default
+    // for chunk streams, and an offline recompress pass (Convert already rewrites rdc->rdc,
+    // it just needs a flag to re-encode sections at zstd-19 with filters). Readers select by
+    // flags, so old builds reject only files actually using new codecs.
+    //
+    // Format note: archive analysis shows heavy redundancy BETWEEN chunks (repeated descriptor
+    // updates, near-identical command buffers) that the block compressor can't see across its
+    // 128KB windows. A v2 frame-capture format could dedup identical chunk bodies by hash
+    // (written once, referenced after - duplicates skip compression entirely) and train a zstd
+    // dictionary over chunk payloads for the remainder. The catch is this layer only sees a
+    // byte stream: chunk boundaries live in the serialiser, so the dedup hook belongs in
+    // WriteChunk/Chunk::Create handing framed chunk bodies to a chunk-aware section writer,
+    // with StreamReader-side reassembly keyed by the same table.
+    uint32_t cores = Threading::NumberOfCores();
+
+    // for the frame capture section, compress pages across a worker pool when there are cores
+    // to spare, and hand the whole chain to a background thread so the application's presenting
+    // thread only pays the ring memcpy - it blocks only if it outruns compression and disk I/O
+    // by more than the ring size.
+    if(props.type == SectionType::FrameCapture && cores > 1)
+    {
+      Compressor *zstd;
+
+      if(cores > 2)
+        zstd = new ZSTDPipelinedCompressor(fileWriter, Ownership::Stream, RDCMIN(cores - 1, 8U));
+      else
+        zstd = new ZSTDCompressor(fileWriter, Ownership::Stream);
+
+      compWriter =
+          new StreamWriter(new ThreadedCompressor(zstd, Ownership::Stream), Ownership::Stream);
+    }
+    else
+    {
+      compWriter =
+          new StreamWriter(new ZSTDCompressor(fileWriter, Ownership::Stream), Ownership::Stream);
+    }
   }
 
   uint64_t dataOffset = FileIO::ftell64(m_File);
@@ -0,0 +1,177 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+// serialisation microbenchmarks, to catch throughput regressions before they show up in
+// production captures. These are hidden behind the [bench] tag so the normal unit test run
+// stays fast - run them with:
+//
+//     renderdoccmd test unit "[bench]"
+//
+// Each benchmark prints one JSON line  {"bench": "...", "value": ..., "unit": "..."}  on stdout
+// so CI can collect and trend the numbers.
+
+#include "common/timing.h"
+#include "core/intervals.h"
+#include "lz4io.h"
+#include "serialiser.h"
+#include "zstdio.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+
+static void ReportBenchmark(const char *name, double value, const char *unit)
+{
+  printf("{\"bench\": \"%s\", \"value\": %.2f, \"unit\": \"%s\"}\n", name, value, unit);
+}
+
+// mixed compressible/random data, the shape capture payloads tend to have
+static void FillTestData(byte *data, size_t size)
+{
+  for(size_t i = 0; i < size; i++)
+    data[i] = (i % 3 == 0) ? byte(i >> 8) : byte((i * 2654435761U) >> 13);
+}
+
+TEST_CASE("Benchmark chunk write throughput", "[.][bench]")
+{
+  const uint32_t chunkSize = 4 * 1024;
+  const uint32_t numChunks = 16 * 1024;
+
+  std::vector<byte> payload(chunkSize);
+  FillTestData(payload.data(), payload.size());
+
+  WriteSerialiser ser(new StreamWriter(64 * 1024 * 1024), Ownership::Stream);
+
+  PerformanceTimer timer;
+
+  for(uint32_t i = 0; i < numChunks; i++)
+  {
+    SCOPED_SERIALISE_CHUNK(42);
+
+    byte *data = payload.data();
+    uint64_t size = payload.size();
+    ser.Serialise("payload"_lit, data, size, SerialiserFlags::NoFlags);
+  }
+
+  const double seconds = timer.GetMilliseconds() / 1000.0;
+  const double totalMB = double(uint64_t(chunkSize) * numChunks) / (1024.0 * 1024.0);
+
+  CHECK(ser.GetWriter()->GetOffset() > uint64_t(chunkSize) * numChunks);
+
+  ReportBenchmark("chunk_write_throughput", totalMB / seconds, "MB/s");
+};
+
+TEST_CASE("Benchmark chunk record and free", "[.][bench]")
+{
+  const uint32_t numChunks = 64 * 1024;
+
+  WriteSerialiser ser(new StreamWriter(64 * 1024), Ownership::Stream);
+
+  uint64_t value = 42;
+
+  PerformanceTimer timer;
+
+  for(uint32_t i = 0; i < numChunks; i++)
+  {
+    ser.WriteChunk(42);
+    ser.Serialise("value"_lit, value);
+    ser.EndChunk();
+
+    Chunk *chunk = Chunk::Create(ser, 42);
+
+    delete chunk;
+  }
+
+  const double micros = timer.GetMicroseconds();
+
+  ReportBenchmark("chunk_record_free", micros / numChunks, "us/chunk");
+};
+
+TEST_CASE("Benchmark compressor streaming rates", "[.][bench]")
+{
+  const size_t dataSize = 64 * 1024 * 1024;
+
+  byte *data = new byte[dataSize];
+  FillTestData(data, dataSize);
+
+  {
+    StreamWriter sink(StreamWriter::DefaultScratchSize);
+    StreamWriter writer(new ZSTDCompressor(&sink, Ownership::Nothing), Ownership::Stream);
+
+    PerformanceTimer timer;
+
+    writer.Write(data, dataSize);
+    writer.Finish();
+
+    const double seconds = timer.GetMilliseconds() / 1000.0;
+
+    REQUIRE_FALSE(writer.IsErrored());
+
+    ReportBenchmark("zstd_compress_rate", double(dataSize) / (1024.0 * 1024.0) / seconds, "MB/s");
+  }
+
+  {
+    StreamWriter sink(StreamWriter::DefaultScratchSize);
+    StreamWriter writer(new LZ4Compressor(&sink, Ownership::Nothing), Ownership::Stream);
+
+    PerformanceTimer timer;
+
+    writer.Write(data, dataSize);
+    writer.Finish();
+
+    const double seconds = timer.GetMilliseconds() / 1000.0;
+
+    REQUIRE_FALSE(writer.IsErrored());
+
+    ReportBenchmark("lz4_compress_rate", double(dataSize) / (1024.0 * 1024.0) / seconds, "MB/s");
+  }
+
+  delete[] data;
+};
+
+TEST_CASE("Benchmark Intervals update cost", "[.][bench]")
+{
+  const uint32_t numUpdates = 256 * 1024;
+
+  Intervals<int> intervals;
+
+  PerformanceTimer timer;
+
+  // pseudo-random scattered range updates, the pattern per-range memory refs produce
+  for(uint32_t i = 0; i < numUpdates; i++)
+  {
+    uint64_t start = (uint64_t(i) * 2654435761U) % (256 * 1024 * 1024);
+    uint64_t length = 4096 + (i % 16) * 4096;
+
+    intervals.update(start, start + length, 1, [](int a, int b) { return a + b; });
+  }
+
+  const double micros = timer.GetMicroseconds();
+
+  CHECK(intervals.size() > 1);
+
+  ReportBenchmark("intervals_update", micros / numUpdates, "us/update");
+};
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
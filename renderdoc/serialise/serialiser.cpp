@@ -36,6 +36,11 @@ int64_t Chunk::m_TotalMem = 0;
 
 #endif
 
+volatile int64_t Chunk::m_RecordedChunks = 0;
+volatile int64_t Chunk::m_RecordedBytes = 0;
+volatile int64_t Chunk::m_ChunkTypeCount[Chunk::ChunkStatsSize] = {};
+volatile int64_t Chunk::m_ChunkTypeBytes[Chunk::ChunkStatsSize] = {};
+
 /////////////////////////////////////////////////////////////
 // Read Serialiser functions
 
@@ -66,6 +71,8 @@ uint32_t Serialiser<SerialiserMode::Reading>::BeginChunk(uint32_t, uint64_t)
 
   m_ChunkMetadata = SDChunkMetaData();
 
+  m_ChunkMetadata.byteOffset = m_Read->GetOffset();
+
   {
     uint32_t c = 0;
     bool success = m_Read->Read(c);
@@ -584,6 +591,7 @@ void DoSerialise(SerialiserType &ser, SDChunkMetaData &el)
   SERIALISE_MEMBER(flags);
   SERIALISE_MEMBER(length);
   SERIALISE_MEMBER(threadID);
+  SERIALISE_MEMBER(byteOffset);
   SERIALISE_MEMBER(durationMicro);
   SERIALISE_MEMBER(timestampMicro);
   SERIALISE_MEMBER(callstack);
@@ -25,6 +25,7 @@
 #pragma once
 
 #include <list>
+#include <new>
 #include <set>
 #include <string>
 #include <vector>
@@ -1751,7 +1752,7 @@ class Chunk
 public:
   ~Chunk()
   {
-    FreeAlignedBuffer(m_Data);
+    // m_Data lives inside this chunk's own allocation, freed alongside it in operator delete
 
 #if !defined(RELEASE)
     Atomic::Dec64(&m_LiveChunks);
@@ -1772,43 +1773,29 @@ public:
   static uint64_t TotalMem() { return 0; }
 #endif
 
-  // grab current contents of the serialiser into this chunk
-  Chunk(Serialiser<SerialiserMode::Writing> &ser, uint32_t chunkType)
+  // grab current contents of the serialiser into a new chunk. The contents live inline in the
+  // same allocation as the chunk itself, so recording a call costs one allocation instead of
+  // two - this is on the hot path of every wrapped call while capturing.
+  static Chunk *Create(Serialiser<SerialiserMode::Writing> &ser, uint32_t chunkType)
   {
-    m_Length = (uint32_t)ser.GetWriter()->GetOffset();
-
     RDCASSERT(ser.GetWriter()->GetOffset() < 0xffffffff);
 
-    m_ChunkType = chunkType;
-
-    m_Data = AllocAlignedBuffer(m_Length);
+    Chunk *ret = AllocateInline((uint32_t)ser.GetWriter()->GetOffset(), chunkType);
 
-    memcpy(m_Data, ser.GetWriter()->GetData(), (size_t)m_Length);
+    memcpy(ret->m_Data, ser.GetWriter()->GetData(), (size_t)ret->m_Length);
 
     ser.GetWriter()->Rewind();
 
-#if !defined(RELEASE)
-    Atomic::Inc64(&m_LiveChunks);
-    Atomic::ExchAdd64(&m_TotalMem, int64_t(m_Length));
-#endif
+    return ret;
   }
 
   byte *GetData() const { return m_Data; }
   Chunk *Duplicate()
   {
-    Chunk *ret = new Chunk();
-    ret->m_Length = m_Length;
-    ret->m_ChunkType = m_ChunkType;
-
-    ret->m_Data = AllocAlignedBuffer(m_Length);
+    Chunk *ret = AllocateInline(m_Length, m_ChunkType);
 
     memcpy(ret->m_Data, m_Data, (size_t)m_Length);
 
-#if !defined(RELEASE)
-    Atomic::Inc64(&m_LiveChunks);
-    Atomic::ExchAdd64(&m_TotalMem, int64_t(m_Length));
-#endif
-
     return ret;
   }
 
@@ -1817,11 +1804,103 @@ public:
     ser.GetWriter()->Write((const void *)m_Data, (size_t)m_Length);
   }
 
+  // chunks only come from AllocateInline(), so pair deletion with the aligned allocation
+  void operator delete(void *p) { FreeAlignedBuffer((byte *)p); }
+
+  // per-chunk-type histogram of recording cost, attributing capture hitches to specific API
+  // calls ("your 40k push constant updates cost this much to record"). Indexed by chunk type up
+  // to this fixed bound; IDs beyond it are lumped into the last bucket.
+  static const uint32_t ChunkStatsSize = 2048;
+
+  // copies the per-type (count, bytes) histograms accumulated since the last drain and zeroes
+  // them. Either array may be NULL to discard. Arrays must hold ChunkStatsSize entries.
+  static void DrainChunkTypeStats(uint64_t *counts, uint64_t *bytes)
+  {
+    for(uint32_t i = 0; i < ChunkStatsSize; i++)
+    {
+      int64_t c = Atomic::ExchAdd64(&m_ChunkTypeCount[i], 0);
+      int64_t b = Atomic::ExchAdd64(&m_ChunkTypeBytes[i], 0);
+
+      c = RDCMAX<int64_t>(c, 0);
+      b = RDCMAX<int64_t>(b, 0);
+
+      Atomic::ExchAdd64(&m_ChunkTypeCount[i], -c);
+      Atomic::ExchAdd64(&m_ChunkTypeBytes[i], -b);
+
+      if(counts)
+        counts[i] = uint64_t(c);
+      if(bytes)
+        bytes[i] = uint64_t(b);
+    }
+  }
+
+  // drains the running count of chunks/bytes recorded since the last call, for the capture
+  // overlay's per-frame statistics. Counts are gathered per-thread in Create() and flushed to
+  // the shared counters in batches, so the recording hot path stays contention-free.
+  static void DrainRecordingStats(uint64_t &chunks, uint64_t &bytes)
+  {
+    int64_t c = Atomic::ExchAdd64(&m_RecordedChunks, 0);
+    int64_t b = Atomic::ExchAdd64(&m_RecordedBytes, 0);
+
+    // concurrent drains (multiple swapchains ticking) can race and drive the counters briefly
+    // negative - never report or subtract a negative snapshot
+    c = RDCMAX<int64_t>(c, 0);
+    b = RDCMAX<int64_t>(b, 0);
+
+    Atomic::ExchAdd64(&m_RecordedChunks, -c);
+    Atomic::ExchAdd64(&m_RecordedBytes, -b);
+
+    chunks = uint64_t(c);
+    bytes = uint64_t(b);
+  }
+
 private:
   Chunk() = default;
   Chunk(const Chunk &) = delete;
   Chunk &operator=(const Chunk &) = delete;
 
+  static Chunk *AllocateInline(uint32_t length, uint32_t chunkType)
+  {
+    // keep the contents at the alignment AllocAlignedBuffer used to guarantee for them
+    const uint64_t headerSize = AlignUp<uint64_t>(sizeof(Chunk), 64);
+
+    byte *alloc = AllocAlignedBuffer(headerSize + length);
+
+    Chunk *ret = new(alloc) Chunk();
+
+    ret->m_Length = length;
+    ret->m_ChunkType = chunkType;
+    ret->m_Data = alloc + headerSize;
+
+#if !defined(RELEASE)
+    Atomic::Inc64(&m_LiveChunks);
+    Atomic::ExchAdd64(&m_TotalMem, int64_t(length));
+#endif
+
+    // per-thread stats batch, flushed to the shared counters every 64 chunks
+    static thread_local uint32_t statsChunks = 0;
+    static thread_local uint64_t statsBytes = 0;
+
+    statsChunks++;
+    statsBytes += length;
+
+    // per-type histogram for cost attribution - two uncontended-in-practice atomic adds
+    uint32_t statsIndex = RDCMIN(chunkType, ChunkStatsSize - 1);
+    Atomic::Inc64(&m_ChunkTypeCount[statsIndex]);
+    Atomic::ExchAdd64(&m_ChunkTypeBytes[statsIndex], int64_t(length));
+
+    if(statsChunks >= 64)
+    {
+      Atomic::ExchAdd64(&m_RecordedChunks, int64_t(statsChunks));
+      Atomic::ExchAdd64(&m_RecordedBytes, int64_t(statsBytes));
+
+      statsChunks = 0;
+      statsBytes = 0;
+    }
+
+    return ret;
+  }
+
   friend class ScopedChunk;
 
   uint32_t m_ChunkType;
@@ -1832,6 +1911,9 @@ private:
 #if !defined(RELEASE)
   static int64_t m_LiveChunks, m_TotalMem;
 #endif
+
+  static volatile int64_t m_RecordedChunks, m_RecordedBytes;
+  static volatile int64_t m_ChunkTypeCount[], m_ChunkTypeBytes[];
 };
 
 #ifndef SERIALISER_IMPL
@@ -1853,7 +1935,7 @@ public:
   Chunk *Get()
   {
     End();
-    return new Chunk(m_Ser, m_Idx);
+    return Chunk::Create(m_Ser, m_Idx);
   }
 
 private:
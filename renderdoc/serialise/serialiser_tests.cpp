@@ -545,6 +545,8 @@ TEST_CASE("Read/write chunk metadata", "[serialiser]")
 
     SDChunkMetaData &md = ser.GetStructuredFile().chunks[0]->metadata;
 
+    // the only chunk in this stream starts at the beginning
+    CHECK(md.byteOffset == 0);
     CHECK(md.threadID == 12345ULL);
     CHECK(md.durationMicro == 445566ULL);
     CHECK(md.timestampMicro == 987654321ULL);
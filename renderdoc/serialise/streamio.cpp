@@ -41,6 +41,19 @@ Decompressor::~Decompressor()
 static const uint64_t initialBufferSize = 64 * 1024;
 const byte StreamWriter::empty[128] = {};
 
+StreamReader::StreamReader(StreamExternalType, const byte *buffer, uint64_t bufferSize)
+{
+  m_InputSize = m_BufferSize = bufferSize;
+
+  // we only ever read from the buffer, but the head/base pointers are shared with the owning
+  // reader case so it's stored non-const.
+  m_BufferHead = m_BufferBase = (byte *)buffer;
+
+  m_ExternalBuffer = true;
+
+  m_Ownership = Ownership::Nothing;
+}
+
 StreamReader::StreamReader(const byte *buffer, uint64_t bufferSize)
 {
   m_InputSize = m_BufferSize = bufferSize;
@@ -178,7 +191,8 @@ StreamReader::~StreamReader()
   for(StreamCloseCallback cb : m_Callbacks)
     cb();
 
-  FreeAlignedBuffer(m_BufferBase);
+  if(!m_ExternalBuffer)
+    FreeAlignedBuffer(m_BufferBase);
 
   if(m_Ownership == Ownership::Stream)
   {
@@ -418,27 +432,20 @@ StreamWriter::~StreamWriter()
 
 bool StreamWriter::SendSocketData(const void *data, uint64_t numBytes)
 {
-  // try to coalesce small writes without doing blocking sends, at least until we're flushed.
-  // if the buffer is already full, flush it.
+  // if it's larger than our buffer, send whatever is coalesced plus the payload as one
+  // gathered write - a single syscall and (with TCP_NODELAY) a single packet train, instead
+  // of a flush send followed by a payload send
   if(m_BufferHead + numBytes >= m_BufferEnd)
   {
-    bool success = FlushSocketData();
+    bool success = m_Sock->SendDataBlocking2(m_BufferBase, uint32_t(m_BufferHead - m_BufferBase),
+                                             data, (uint32_t)numBytes);
     if(!success)
     {
       HandleError();
       return false;
     }
-  }
 
-  // if it's larger than our buffer (even after flushing) just write directly
-  if(m_BufferHead + numBytes >= m_BufferEnd)
-  {
-    bool success = m_Sock->SendDataBlocking(data, (uint32_t)numBytes);
-    if(!success)
-    {
-      HandleError();
-      return false;
-    }
+    m_BufferHead = m_BufferBase;
   }
   else
   {
@@ -504,6 +511,16 @@ void StreamTransfer(StreamWriter *writer, StreamReader *reader, RENDERDOC_Progre
 {
   uint64_t totalSize = reader->GetSize();
 
+  // nothing to copy - e.g. resuming a transfer that already completed, or a missing source.
+  // Guard here rather than dividing by a zero buffer size below.
+  if(totalSize == 0)
+  {
+    if(progress)
+      progress(1.0f);
+
+    return;
+  }
+
   // copy 1MB at a time
   const uint64_t StreamIOChunkSize = 1024 * 1024;
 
@@ -534,4 +551,124 @@ void StreamTransfer(StreamWriter *writer, StreamReader *reader, RENDERDOC_Progre
     progress(1.0f);
 
   delete[] buf;
-}
\ No newline at end of file
+}
+ThreadedCompressor::ThreadedCompressor(Compressor *inner, Ownership own)
+    : Compressor(NULL, Ownership::Nothing)
+{
+  m_Inner = inner;
+  m_InnerOwnership = own;
+
+  // large enough to absorb a burst of chunk writes while compression catches up
+  m_RingSize = 8 * 1024 * 1024;
+  m_Ring = AllocAlignedBuffer(m_RingSize);
+
+  m_Thread = Threading::CreateThread([this]() { WriterLoop(); });
+}
+
+ThreadedCompressor::~ThreadedCompressor()
+{
+  // if Finish() was never called, drain and stop the thread without finishing the inner
+  // compressor - an unfinished stream loses its tail either way.
+  Atomic::CmpExch32(&m_FinishRequested, 0, 1);
+
+  Threading::JoinThread(m_Thread);
+  Threading::CloseThread(m_Thread);
+
+  FreeAlignedBuffer(m_Ring);
+
+  if(m_InnerOwnership == Ownership::Stream)
+    delete m_Inner;
+}
+
+bool ThreadedCompressor::Write(const void *data, uint64_t numBytes)
+{
+  if(m_HasError)
+    return false;
+
+  const byte *src = (const byte *)data;
+
+  while(numBytes > 0)
+  {
+    int64_t consumed = Atomic::ExchAdd64(&m_Consumed, 0);
+
+    uint64_t space = m_RingSize - uint64_t(m_Produced - consumed);
+
+    if(space == 0)
+    {
+      // ring full, the writer thread is behind - this is the only place the producer blocks
+      if(m_HasError || m_ThreadDone)
+        return false;
+
+      Threading::Sleep(0);
+      continue;
+    }
+
+    uint64_t offset = uint64_t(m_Produced) % m_RingSize;
+    uint64_t copyBytes = RDCMIN(RDCMIN(space, numBytes), m_RingSize - offset);
+
+    memcpy(m_Ring + offset, src, (size_t)copyBytes);
+
+    src += copyBytes;
+    numBytes -= copyBytes;
+
+    // publish - the atomic add is the write barrier for the memcpy above
+    Atomic::ExchAdd64(&m_Produced, int64_t(copyBytes));
+  }
+
+  return !m_HasError;
+}
+
+void ThreadedCompressor::WriterLoop()
+{
+  for(;;)
+  {
+    // sample the finish flag BEFORE the produced counter. Finish() is called on the producing
+    // thread after its last Write() has published, so a set flag observed here guarantees the
+    // produced count read below already includes every byte. Sampling in the other order could
+    // pair a stale produced count with a freshly-set flag and exit with unconsumed bytes still
+    // in the ring, silently truncating the stream.
+    bool finishRequested = m_FinishRequested != 0;
+
+    int64_t produced = Atomic::ExchAdd64(&m_Produced, 0);
+
+    uint64_t avail = uint64_t(produced - m_Consumed);
+
+    if(avail == 0)
+    {
+      if(finishRequested)
+        break;
+
+      Threading::Sleep(0);
+      continue;
+    }
+
+    uint64_t offset = uint64_t(m_Consumed) % m_RingSize;
+    uint64_t contiguous = RDCMIN(avail, m_RingSize - offset);
+
+    // on error keep consuming so the producer never blocks forever, just discard the data
+    if(!m_HasError)
+    {
+      if(!m_Inner->Write(m_Ring + offset, contiguous))
+        Atomic::CmpExch32(&m_HasError, 0, 1);
+    }
+
+    Atomic::ExchAdd64(&m_Consumed, int64_t(contiguous));
+  }
+
+  Atomic::CmpExch32(&m_ThreadDone, 0, 1);
+}
+
+bool ThreadedCompressor::Finish()
+{
+  Atomic::CmpExch32(&m_FinishRequested, 0, 1);
+
+  // wait for the background thread to drain the ring
+  while(!m_ThreadDone)
+    Threading::Sleep(0);
+
+  bool success = !m_HasError;
+
+  success &= m_Inner->Finish();
+
+  return success;
+}
@@ -53,6 +53,40 @@ protected:
   Ownership m_Ownership;
 };
 
+// pumps writes through a background thread via a single-producer single-consumer byte ring, so
+// the producing thread (e.g. an application's presenting thread while a capture is written)
+// doesn't block on the compression and disk I/O happening in the wrapped compressor. The
+// producer only stalls if it outruns the writer by more than the ring size.
+class ThreadedCompressor : public Compressor
+{
+public:
+  ThreadedCompressor(Compressor *inner, Ownership own);
+  ~ThreadedCompressor();
+
+  bool Write(const void *data, uint64_t numBytes);
+  bool Finish();
+
+private:
+  void WriterLoop();
+
+  Compressor *m_Inner;
+  Ownership m_InnerOwnership;
+
+  byte *m_Ring;
+  uint64_t m_RingSize;
+
+  // total bytes produced/consumed - ring offsets are these modulo the ring size. Only the
+  // producing thread writes m_Produced, only the writer thread writes m_Consumed.
+  volatile int64_t m_Produced = 0;
+  volatile int64_t m_Consumed = 0;
+
+  volatile int32_t m_FinishRequested = 0;
+  volatile int32_t m_ThreadDone = 0;
+  volatile int32_t m_HasError = 0;
+
+  Threading::ThreadHandle m_Thread;
+};
+
 class Decompressor
 {
 public:
@@ -77,9 +111,17 @@ public:
   {
     DummyStream
   };
+  enum StreamExternalType
+  {
+    ExternalBuffer
+  };
 
   StreamReader(StreamInvalidType);
   StreamReader(StreamDummyType);
+  // wraps an externally-owned buffer (e.g. a mapped view of a file) without copying it. The
+  // buffer must stay valid for the reader's lifetime - use AddCloseCallback to tie any cleanup
+  // to the reader's destruction.
+  StreamReader(StreamExternalType, const byte *buffer, uint64_t bufferSize);
   StreamReader(const byte *buffer, uint64_t bufferSize);
   StreamReader(const std::vector<byte> &buffer);
 
@@ -240,6 +282,9 @@ private:
   // structured serialiser to 'read' pre-existing data.
   bool m_Dummy = false;
 
+  // flag indicating the buffer is externally owned and shouldn't be freed on destruction.
+  bool m_ExternalBuffer = false;
+
   // do we own the file/compressor? are we responsible for
   // cleaning it up?
   Ownership m_Ownership;
@@ -94,6 +94,46 @@ TEST_CASE("Test basic stream I/O operations", "[streamio]")
   CHECK(reader.IsErrored());
 };
 
+TEST_CASE("Test external buffer stream reading", "[streamio]")
+{
+  byte data[64];
+  for(size_t i = 0; i < sizeof(data); i++)
+    data[i] = byte(i * 3);
+
+  bool closed = false;
+
+  {
+    // the reader borrows the buffer rather than copying it
+    StreamReader reader(StreamReader::ExternalBuffer, data, sizeof(data));
+
+    reader.AddCloseCallback([&closed]() { closed = true; });
+
+    CHECK(reader.GetSize() == sizeof(data));
+
+    byte test[16];
+    reader.Read(test, sizeof(test));
+    CHECK_FALSE(memcmp(test, data, sizeof(test)));
+
+    // mutating the underlying buffer is visible through the reader, since there's no copy
+    data[16] = 0xff;
+
+    byte b = 0;
+    reader.Read(b);
+    CHECK(b == 0xff);
+
+    reader.SetOffset(sizeof(data) - 1);
+    reader.Read(b);
+    CHECK(b == byte(63 * 3));
+
+    CHECK_FALSE(reader.IsErrored());
+    CHECK(reader.AtEnd());
+
+    CHECK_FALSE(closed);
+  }
+
+  CHECK(closed);
+};
+
 TEST_CASE("Test stream I/O operations over the network", "[streamio][network]")
 {
   uint16_t port = 8235;
@@ -24,6 +24,15 @@
 
 #define ZSTD_STATIC_LINKING_ONLY
 #include "zstdio.h"
+#include "common/threading.h"
+
+// Multi-frame note: each page is an independent frame (deliberately - it's what enables the
+// pipelined compressor and decompressor), which means N nearly-identical frames in a
+// multi-frame capture compress to ~N times one frame. Long-range mode needs a window spanning
+// frames, i.e. giving up per-page independence for the multi-frame section specifically: a new
+// section flag selecting a single long-window zstd stream with explicit frame-boundary seek
+// points recorded beside it, so loads can still jump to a frame without decompressing
+// everything before it.
 
 static const uint64_t zstdBlockSize = 128 * 1024;
 static const uint64_t compressBlockSize = ZSTD_compressBound(zstdBlockSize);
@@ -343,3 +352,424 @@ bool ZSTDDecompressor::FillPage()
 
   return success;
 }
+
+ZSTDPipelinedDecompressor::ZSTDPipelinedDecompressor(StreamReader *read, Ownership own,
+                                                    uint32_t numThreads)
+    : Decompressor(read, own)
+{
+  numThreads = RDCMAX(1U, numThreads);
+
+  // keep two slots in flight per worker, so that workers always have a frame to decompress while
+  // the consumer is draining the oldest one.
+  m_Slots.resize(numThreads * 2);
+
+  for(PageSlot &slot : m_Slots)
+  {
+    slot.compressed = AllocAlignedBuffer(compressBlockSize);
+    slot.page = AllocAlignedBuffer(zstdBlockSize);
+  }
+
+  m_ActiveThreads = (int32_t)numThreads;
+
+  for(uint32_t i = 0; i < numThreads; i++)
+    m_Threads.push_back(Threading::CreateThread([this]() { WorkerLoop(); }));
+}
+
+ZSTDPipelinedDecompressor::~ZSTDPipelinedDecompressor()
+{
+  Atomic::CmpExch32(&m_Kill, 0, 1);
+
+  for(Threading::ThreadHandle thread : m_Threads)
+  {
+    Threading::JoinThread(thread);
+    Threading::CloseThread(thread);
+  }
+
+  for(PageSlot &slot : m_Slots)
+  {
+    FreeAlignedBuffer(slot.compressed);
+    FreeAlignedBuffer(slot.page);
+  }
+}
+
+void ZSTDPipelinedDecompressor::WorkerLoop()
+{
+  ZSTD_DStream *stream = ZSTD_createDStream();
+
+  for(;;)
+  {
+    PageSlot *slot = NULL;
+    uint32_t compSize = 0;
+
+    {
+      SCOPED_LOCK(m_ReadLock);
+
+      if(m_Kill || m_Error || m_Read->IsErrored() || m_Read->AtEnd())
+        break;
+
+      slot = &m_Slots[size_t(m_FetchTicket % m_Slots.size())];
+
+      // wait for the consumer to drain this slot before re-using it. We spin while holding the
+      // read lock, but that's fine - if the ring has wrapped the other workers have nothing to
+      // fetch either.
+      while(slot->state != SlotEmpty && !m_Kill && !m_Error)
+        Threading::Sleep(0);
+
+      if(m_Kill || m_Error)
+        break;
+
+      slot->state = SlotFetching;
+
+      bool success = m_Read->Read(compSize);
+
+      if(!success || compSize > compressBlockSize)
+      {
+        RDCERR("Invalid frame header in pipelined zstd stream");
+        Atomic::CmpExch32(&m_Error, 0, 1);
+        break;
+      }
+
+      success = m_Read->Read(slot->compressed, compSize);
+
+      if(!success)
+      {
+        Atomic::CmpExch32(&m_Error, 0, 1);
+        break;
+      }
+
+      m_FetchTicket++;
+    }
+
+    // decompress the frame we claimed, outside the read lock so other workers can fetch.
+    size_t err = ZSTD_initDStream(stream);
+
+    ZSTD_inBuffer in = {slot->compressed, compSize, 0};
+    ZSTD_outBuffer out = {slot->page, zstdBlockSize, 0};
+
+    while(!ZSTD_isError(err) && in.pos < in.size)
+    {
+      size_t inpos = in.pos;
+      size_t outpos = out.pos;
+
+      err = ZSTD_decompressStream(stream, &out, &in);
+
+      if(!ZSTD_isError(err) && inpos == in.pos && outpos == out.pos)
+      {
+        RDCERR("Error decompressing, no progress made");
+        Atomic::CmpExch32(&m_Error, 0, 1);
+        break;
+      }
+    }
+
+    if(ZSTD_isError(err))
+    {
+      RDCERR("Error decompressing: %s", ZSTD_getErrorName(err));
+      Atomic::CmpExch32(&m_Error, 0, 1);
+    }
+
+    if(m_Error)
+      break;
+
+    slot->pageLength = out.pos;
+
+    // publish the decompressed page - the atomic acts as the write barrier for the data above.
+    Atomic::CmpExch32(&slot->state, SlotFetching, SlotDone);
+  }
+
+  ZSTD_freeDStream(stream);
+
+  Atomic::Dec32(&m_ActiveThreads);
+}
+
+bool ZSTDPipelinedDecompressor::WaitForPage(PageSlot &slot)
+{
+  while(slot.state != SlotDone)
+  {
+    if(m_Error)
+      return false;
+
+    // if all the workers have exited and the slot still hasn't been published, the input ran out
+    // of frames. Re-check the state after observing the thread count to close the race against a
+    // worker publishing its last page just before exiting.
+    if(m_ActiveThreads == 0 && slot.state != SlotDone)
+      return false;
+
+    Threading::Sleep(0);
+  }
+
+  return true;
+}
+
+bool ZSTDPipelinedDecompressor::Recompress(Compressor *comp)
+{
+  bool success = true;
+
+  while(success)
+  {
+    PageSlot &slot = m_Slots[size_t(m_ReadTicket % m_Slots.size())];
+
+    // distinguish 'input exhausted' (normal termination) from a stream error below.
+    if(!WaitForPage(slot))
+      break;
+
+    success &= comp->Write(slot.page, slot.pageLength);
+
+    m_ReadTicket++;
+    Atomic::CmpExch32(&slot.state, SlotDone, SlotEmpty);
+  }
+
+  if(m_Error)
+    success = false;
+
+  success &= comp->Finish();
+
+  return success;
+}
+
+bool ZSTDPipelinedDecompressor::Read(void *data, uint64_t numBytes)
+{
+  if(numBytes == 0)
+    return true;
+
+  byte *dst = (byte *)data;
+
+  while(numBytes > 0)
+  {
+    PageSlot &slot = m_Slots[size_t(m_ReadTicket % m_Slots.size())];
+
+    if(!WaitForPage(slot))
+      return false;
+
+    uint64_t available = slot.pageLength - m_PageOffset;
+    uint64_t copyBytes = RDCMIN(available, numBytes);
+
+    memcpy(dst, slot.page + m_PageOffset, (size_t)copyBytes);
+
+    dst += copyBytes;
+    m_PageOffset += copyBytes;
+    numBytes -= copyBytes;
+
+    // consumed the whole page, hand the slot back to the workers.
+    if(m_PageOffset == slot.pageLength)
+    {
+      m_PageOffset = 0;
+      m_ReadTicket++;
+      Atomic::CmpExch32(&slot.state, SlotDone, SlotEmpty);
+    }
+  }
+
+  return true;
+}
+
+ZSTDPipelinedCompressor::ZSTDPipelinedCompressor(StreamWriter *write, Ownership own,
+                                                uint32_t numThreads)
+    : Compressor(write, own)
+{
+  numThreads = RDCMAX(1U, numThreads);
+
+  m_Slots.resize(numThreads * 2);
+
+  for(PageSlot &slot : m_Slots)
+  {
+    slot.page = AllocAlignedBuffer(zstdBlockSize);
+    slot.compressed = AllocAlignedBuffer(compressBlockSize);
+  }
+
+  for(uint32_t i = 0; i < numThreads; i++)
+  {
+    m_Threads.push_back(Threading::CreateThread([this]() {
+      ZSTD_CStream *stream = ZSTD_createCStream();
+
+      for(;;)
+      {
+        // claim the next page to compress. The claim can run ahead of the pages actually
+        // filled, so wait for the slot to be handed over by the producer.
+        // Inc64 returns the post-increment value on every platform, making the claimed ticket
+        // unambiguous (see the contract note in os_specific.h)
+        int64_t ticket = Atomic::Inc64(&m_CompressTicket) - 1;
+
+        PageSlot &slot = m_Slots[size_t(uint64_t(ticket) % m_Slots.size())];
+
+        // claim the slot once it's been filled *for our ticket* - with a slow sibling the ring
+        // can wrap, so both the generation and the state transition are checked atomically
+        for(;;)
+        {
+          if(m_Kill || m_Error)
+            break;
+
+          if(slot.state == SlotFilled && slot.ticket == uint64_t(ticket) &&
+             Atomic::CmpExch32(&slot.state, SlotFilled, SlotCompressing) == SlotFilled)
+            break;
+
+          Threading::Sleep(0);
+        }
+
+        if(m_Kill || m_Error)
+          break;
+
+        size_t err = ZSTD_initCStream(stream, 7);
+
+        ZSTD_inBuffer in = {slot.page, (size_t)slot.pageLength, 0};
+        ZSTD_outBuffer out = {slot.compressed, (size_t)compressBlockSize, 0};
+
+        while(!ZSTD_isError(err) && in.pos < in.size)
+        {
+          size_t inpos = in.pos;
+          size_t outpos = out.pos;
+
+          err = ZSTD_compressStream(stream, &out, &in);
+
+          if(!ZSTD_isError(err) && inpos == in.pos && outpos == out.pos)
+          {
+            RDCERR("Error compressing, no progress made");
+            Atomic::CmpExch32(&m_Error, 0, 1);
+            break;
+          }
+        }
+
+        if(!ZSTD_isError(err))
+          err = ZSTD_endStream(stream, &out);
+
+        if(ZSTD_isError(err) || err != 0)
+        {
+          RDCERR("Error compressing page");
+          Atomic::CmpExch32(&m_Error, 0, 1);
+          break;
+        }
+
+        slot.compressedLength = (uint32_t)out.pos;
+
+        // publish - the atomic acts as the write barrier for the compressed data
+        Atomic::CmpExch32(&slot.state, SlotCompressing, SlotCompressed);
+      }
+
+      ZSTD_freeCStream(stream);
+    }));
+  }
+}
+
+ZSTDPipelinedCompressor::~ZSTDPipelinedCompressor()
+{
+  Atomic::CmpExch32(&m_Kill, 0, 1);
+
+  for(Threading::ThreadHandle thread : m_Threads)
+  {
+    Threading::JoinThread(thread);
+    Threading::CloseThread(thread);
+  }
+
+  for(PageSlot &slot : m_Slots)
+  {
+    FreeAlignedBuffer(slot.page);
+    FreeAlignedBuffer(slot.compressed);
+  }
+}
+
+bool ZSTDPipelinedCompressor::QueuePage()
+{
+  PageSlot &slot = m_Slots[size_t(m_FillTicket % m_Slots.size())];
+
+  slot.pageLength = m_PageOffset;
+  slot.ticket = m_FillTicket;
+
+  // hand the slot to the workers
+  Atomic::CmpExch32(&slot.state, SlotEmpty, SlotFilled);
+
+  m_FillTicket++;
+  m_PageOffset = 0;
+
+  // opportunistically flush whatever has finished, and make sure the next fill slot is free
+  if(!DrainWritten(false))
+    return false;
+
+  PageSlot &next = m_Slots[size_t(m_FillTicket % m_Slots.size())];
+
+  while(next.state != SlotEmpty && !m_Error)
+  {
+    if(!DrainWritten(false))
+      return false;
+
+    Threading::Sleep(0);
+  }
+
+  return !m_Error;
+}
+
+bool ZSTDPipelinedCompressor::DrainWritten(bool all)
+{
+  while(m_WriteTicket < m_FillTicket)
+  {
+    PageSlot &slot = m_Slots[size_t(m_WriteTicket % m_Slots.size())];
+
+    if(slot.state != SlotCompressed)
+    {
+      if(m_Error)
+        return false;
+
+      if(!all)
+        return true;
+
+      Threading::Sleep(0);
+      continue;
+    }
+
+    // same framing as the serial compressor: size prefix then the frame
+    bool success = m_Write->Write(slot.compressedLength);
+    success &= m_Write->Write(slot.compressed, slot.compressedLength);
+
+    if(!success)
+    {
+      Atomic::CmpExch32(&m_Error, 0, 1);
+      return false;
+    }
+
+    Atomic::CmpExch32(&slot.state, SlotCompressed, SlotEmpty);
+
+    m_WriteTicket++;
+  }
+
+  return !m_Error;
+}
+
+bool ZSTDPipelinedCompressor::Write(const void *data, uint64_t numBytes)
+{
+  if(m_Error)
+    return false;
+
+  if(numBytes == 0)
+    return true;
+
+  const byte *src = (const byte *)data;
+
+  while(numBytes > 0)
+  {
+    PageSlot &slot = m_Slots[size_t(m_FillTicket % m_Slots.size())];
+
+    uint64_t space = zstdBlockSize - m_PageOffset;
+    uint64_t copyBytes = RDCMIN(space, numBytes);
+
+    memcpy(slot.page + m_PageOffset, src, (size_t)copyBytes);
+
+    m_PageOffset += copyBytes;
+    src += copyBytes;
+    numBytes -= copyBytes;
+
+    if(m_PageOffset == zstdBlockSize)
+    {
+      if(!QueuePage())
+        return false;
+    }
+  }
+
+  return true;
+}
+
+bool ZSTDPipelinedCompressor::Finish()
+{
+  // queue any partial final page, mirroring the serial compressor which writes a final partial
+  // (or empty) block
+  if(!QueuePage())
+    return false;
+
+  return DrainWritten(true);
+}
@@ -67,3 +67,121 @@ private:
 
   ZSTD_DStream *m_Stream;
 };
+
+// a parallel variant of ZSTDCompressor: pages are handed to a pool of worker threads for
+// compression and written out in order, producing output byte-compatible with the serial
+// compressor (each page is an independent zstd frame). The writing thread only blocks when it
+// outruns the workers by a full ring of pages.
+class ZSTDPipelinedCompressor : public Compressor
+{
+public:
+  ZSTDPipelinedCompressor(StreamWriter *write, Ownership own, uint32_t numThreads);
+  ~ZSTDPipelinedCompressor();
+
+  bool Write(const void *data, uint64_t numBytes);
+  bool Finish();
+
+private:
+  enum SlotState : int32_t
+  {
+    SlotEmpty = 0,
+    SlotFilled = 1,
+    SlotCompressing = 2,
+    SlotCompressed = 3,
+  };
+
+  struct PageSlot
+  {
+    byte *page = NULL;
+    byte *compressed = NULL;
+    uint64_t pageLength = 0;
+    uint32_t compressedLength = 0;
+    // which fill this slot currently holds - workers check it before claiming, since with a
+    // slow worker the ring can wrap and a later ticket's worker could otherwise grab a slot
+    // still holding an earlier generation
+    uint64_t ticket = 0;
+    volatile int32_t state = SlotEmpty;
+  };
+
+  // takes the current page and queues it for compression
+  bool QueuePage();
+  // writes out any contiguously-finished pages, optionally blocking until all queued pages are
+  // written
+  bool DrainWritten(bool all);
+
+  std::vector<PageSlot> m_Slots;
+  std::vector<Threading::ThreadHandle> m_Threads;
+
+  // next page index to fill / write; only touched by the producing thread
+  uint64_t m_FillTicket = 0;
+  uint64_t m_WriteTicket = 0;
+
+  // next page index to compress, claimed by workers
+  volatile int64_t m_CompressTicket = 0;
+
+  // current partial page being filled by Write()
+  uint64_t m_PageOffset = 0;
+
+  volatile int32_t m_Kill = 0;
+  volatile int32_t m_Error = 0;
+};
+
+// a parallel variant of ZSTDDecompressor. Since each block compressed by ZSTDCompressor is an
+// independent zstd frame, a pool of worker threads can pull frames off the underlying reader and
+// decompress several of them ahead of the consuming cursor, overlapping decode with whatever
+// processing happens on the data (e.g. replaying chunks out of a capture's frame section).
+class ZSTDPipelinedDecompressor : public Decompressor
+{
+public:
+  ZSTDPipelinedDecompressor(StreamReader *read, Ownership own, uint32_t numThreads);
+  ~ZSTDPipelinedDecompressor();
+
+  bool Recompress(Compressor *comp);
+  bool Read(void *data, uint64_t numBytes);
+
+private:
+  // the state of each page slot in the ring. Slots cycle Empty -> Fetching -> Done -> Empty,
+  // with each transition owned by exactly one thread so the state words only need to act as
+  // publication barriers.
+  enum SlotState : int32_t
+  {
+    SlotEmpty = 0,
+    SlotFetching = 1,
+    SlotDone = 2,
+  };
+
+  struct PageSlot
+  {
+    byte *compressed = NULL;
+    byte *page = NULL;
+    uint64_t pageLength = 0;
+    volatile int32_t state = SlotEmpty;
+  };
+
+  void WorkerLoop();
+  bool NextPage();
+
+  // waits for the slot owning the next ordered page to be decompressed, returning false on
+  // stream error or if the input ran out of frames.
+  bool WaitForPage(PageSlot &slot);
+
+  std::vector<PageSlot> m_Slots;
+  std::vector<Threading::ThreadHandle> m_Threads;
+
+  // protects reads from m_Read - frames are pulled off the stream serially, then decompressed in
+  // parallel.
+  Threading::CriticalSection m_ReadLock;
+
+  // the next frame index to be pulled off the stream, owned by m_ReadLock
+  uint64_t m_FetchTicket = 0;
+
+  // the next frame index to be consumed by Read(), only touched on the consuming thread
+  uint64_t m_ReadTicket = 0;
+
+  // current read position within the page being consumed
+  uint64_t m_PageOffset = 0;
+
+  volatile int32_t m_ActiveThreads = 0;
+  volatile int32_t m_Kill = 0;
+  volatile int32_t m_Error = 0;
+};
@@ -107,6 +107,39 @@ void DisplayRendererPreview(IReplayController *renderer, uint32_t width, uint32_
 std::map<std::string, Command *> commands;
 std::map<std::string, std::string> aliases;
 
+// Comparison note: regression hunting between two builds' captures of the same scene is manual
+// today. A 'compare a.rdc b.rdc --report json' command fits here: two replay controllers
+// advanced in lockstep through marker-aligned steps (AlignDrawcallTrees produces the event
+// pairing), render targets compared per step via a GPU difference reduction, and the first
+// divergence bisected to an event pair in the report. The warm-device pool below is the
+// natural host since the comparison wants both devices alive for the whole walk.
+//
+// Archive note: an 'index' command rounds out the archive tooling: walk a directory tree
+// reading just the FrameStats/thumbnail sections (no replay device), parallelised across files
+// on the worker pool, emitting a compact sidecar database with query flags filtering by API,
+// extension usage, marker names, resolution and event counts - the quick-stats section makes
+// the per-file cost a couple of section reads.
+//
+// Export note: an 'export-video' command also belongs in this table: one replay pass encoding
+// each draw's (or each Nth event's) backbuffer via platform hardware encoders - VAAPI/NVENC/
+// Media Foundation - fed GPU surfaces directly from the replay driver where supported, so
+// review videos render at encode speed instead of screenshot-script speed.
+//
+// Validation note: a 'validate' command belongs in this table eventually: replay a capture N
+// times, hash every render target at marker boundaries via the texture readback paths, report
+// divergence between runs, and emit per-phase timings (load, init state, per-pass) as JSON
+// baselines that CI can diff across versions - catching replay nondeterminism and performance
+// regressions from a capture corpus before upgrades roll out.
+//
+// Batch note: every command that replays (thumb, convert with replay-derived outputs, the
+// proposed validate) pays full replay device creation per file - seconds of VkInstance/device
+// setup amortised over often less than a second of work. Nightly triage over thousands of
+// captures wants a 'serve --pool N' daemon mode here: keep N warm replay devices, accept
+// capture-operation jobs over the target control protocol (the remote server machinery already
+// frames and versions that channel), and reuse a device across captures with compatible
+// drivers, resetting replay state between files. The reset-to-pristine guarantee between
+// unrelated captures is the correctness risk to design around before the pooling is trusted.
+
 void add_command(const std::string &name, Command *cmd)
 {
   commands[name] = cmd;